@@ -23,7 +23,9 @@ CommonAbstractObjectSetToVtkPartitionedDataSetSet::CommonAbstractObjectSetToVtkP
 	: _procNumber(p_procNumber),
 	  _maxProc(p_maxProc),
 	  _resqmlData(p_abstractObject),
-	  _mapperSet()
+	  _mapperSet(),
+	  _geometryPrecision(GeometryPrecision::Double),
+	  _geometryOrigin()
 {
 	_uuid = p_abstractObject->getUuid();
 	_title = p_abstractObject->getTitle();
@@ -42,10 +44,22 @@ void CommonAbstractObjectSetToVtkPartitionedDataSetSet::loadVtkObject()
 {
 	for (uint32_t w_i = _procNumber; w_i < _mapperSet.size(); w_i += _maxProc)
 	{
+		_mapperSet[w_i]->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
 		_mapperSet[w_i]->loadVtkObject();
 	}
 }
 
+//----------------------------------------------------------------------------
+void CommonAbstractObjectSetToVtkPartitionedDataSetSet::setGeometryPrecision(GeometryPrecision p_precision, const std::shared_ptr<std::array<double, 3>> &p_origin)
+{
+	_geometryPrecision = p_precision;
+	_geometryOrigin = p_origin;
+	for (auto *w_mapper : _mapperSet)
+	{
+		w_mapper->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
+	}
+}
+
 //----------------------------------------------------------------------------
 void CommonAbstractObjectSetToVtkPartitionedDataSetSet::removeCommonAbstractObjectToVtkPartitionedDataSet(const std::string &p_id)
 {
@@ -55,6 +55,12 @@ public:
 
 	bool existUuid(const std::string &p_id);
 
+	/**
+	 * Set the precision of the VTK points of all the mappers of this set, including the ones added later.
+	 * See CommonAbstractObjectToVtkPartitionedDataSet::setGeometryPrecision.
+	 */
+	void setGeometryPrecision(GeometryPrecision p_precision, const std::shared_ptr<std::array<double, 3>> &p_origin);
+
 protected:
 	const COMMON_NS::AbstractObject *_resqmlData;
 
@@ -66,5 +72,8 @@ protected:
 	std::string _title;
 
 	std::vector<CommonAbstractObjectToVtkPartitionedDataSet *> _mapperSet;
+
+	GeometryPrecision _geometryPrecision;
+	std::shared_ptr<std::array<double, 3>> _geometryOrigin;
 };
 #endif
@@ -18,6 +18,15 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "CommonAbstractObjectToVtkPartitionedDataSet.h"
 
+#include <cmath>
+
+// include VTK library
+#include <vtkDataObject.h>
+#include <vtkDoubleArray.h>
+#include <vtkFieldData.h>
+#include <vtkFloatArray.h>
+#include <vtkSMPTools.h>
+
 //----------------------------------------------------------------------------
 CommonAbstractObjectToVtkPartitionedDataSet::CommonAbstractObjectToVtkPartitionedDataSet(const COMMON_NS::AbstractObject* p_abstractObject, uint32_t p_procNumber, uint32_t p_maxProc):
 	_procNumber(p_procNumber),
@@ -25,6 +34,92 @@ CommonAbstractObjectToVtkPartitionedDataSet::CommonAbstractObjectToVtkPartitione
 	_vtkData(nullptr),
 	_absUuid(p_abstractObject?p_abstractObject->getUuid():""),
 	_absTitle(p_abstractObject?p_abstractObject->getTitle():""),
+	_geometryPrecision(GeometryPrecision::Double),
+	_geometryOrigin(),
 	_resqmlData(p_abstractObject)
 {
 }
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::setGeometryPrecision(GeometryPrecision p_precision, const std::shared_ptr<std::array<double, 3>> &p_origin)
+{
+	_geometryPrecision = p_precision;
+	_geometryOrigin = p_origin;
+}
+
+//----------------------------------------------------------------------------
+std::array<double, 3> CommonAbstractObjectToVtkPartitionedDataSet::getGeometryOrigin(const double *p_xyzPoint)
+{
+	if (_geometryPrecision == GeometryPrecision::Double || _geometryOrigin == nullptr)
+	{
+		return {{0., 0., 0.}};
+	}
+
+	std::array<double, 3> &w_origin = *_geometryOrigin;
+	if (std::isnan(w_origin[0]) && p_xyzPoint != nullptr &&
+		!std::isnan(p_xyzPoint[0]) && !std::isnan(p_xyzPoint[1]) && !std::isnan(p_xyzPoint[2]))
+	{
+		w_origin = {{p_xyzPoint[0], p_xyzPoint[1], p_xyzPoint[2]}};
+	}
+
+	return std::isnan(w_origin[0]) ? std::array<double, 3>{{0., 0., 0.}} : w_origin;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> CommonAbstractObjectToVtkPartitionedDataSet::createVtkPoints(double *p_allXyzPoints, uint64_t p_pointCount)
+{
+	vtkSmartPointer<vtkPoints> w_vtkPoints = vtkSmartPointer<vtkPoints>::New();
+
+	if (_geometryPrecision == GeometryPrecision::Double)
+	{
+		vtkSmartPointer<vtkDoubleArray> w_vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
+		w_vtkUnderlyingArray->SetNumberOfComponents(3);
+		// Take ownership of the underlying C array
+		w_vtkUnderlyingArray->SetArray(p_allXyzPoints, p_pointCount * 3, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
+		w_vtkPoints->SetData(w_vtkUnderlyingArray);
+		return w_vtkPoints;
+	}
+
+	// Look for the first defined point in case the origin is not initialized yet
+	const double *w_firstPoint = p_allXyzPoints;
+	const double *const w_endPoint = p_allXyzPoints + p_pointCount * 3;
+	while (w_firstPoint != w_endPoint && (std::isnan(w_firstPoint[0]) || std::isnan(w_firstPoint[1]) || std::isnan(w_firstPoint[2])))
+	{
+		w_firstPoint += 3;
+	}
+	const std::array<double, 3> w_origin = getGeometryOrigin(w_firstPoint != w_endPoint ? w_firstPoint : nullptr);
+
+	float *w_allXyzFloatPoints = new float[p_pointCount * 3]; // Will be deleted by VTK
+	vtkSMPTools::For(0, p_pointCount, [p_allXyzPoints, w_allXyzFloatPoints, w_origin](vtkIdType p_pointBegin, vtkIdType p_pointEnd)
+					 {
+						 for (vtkIdType w_coordIndex = p_pointBegin * 3; w_coordIndex < p_pointEnd * 3; w_coordIndex += 3)
+						 {
+							 w_allXyzFloatPoints[w_coordIndex] = static_cast<float>(p_allXyzPoints[w_coordIndex] - w_origin[0]);
+							 w_allXyzFloatPoints[w_coordIndex + 1] = static_cast<float>(p_allXyzPoints[w_coordIndex + 1] - w_origin[1]);
+							 w_allXyzFloatPoints[w_coordIndex + 2] = static_cast<float>(p_allXyzPoints[w_coordIndex + 2] - w_origin[2]);
+						 }
+					 });
+	delete[] p_allXyzPoints;
+
+	vtkSmartPointer<vtkFloatArray> w_vtkUnderlyingArray = vtkSmartPointer<vtkFloatArray>::New();
+	w_vtkUnderlyingArray->SetNumberOfComponents(3);
+	// Take ownership of the underlying C array
+	w_vtkUnderlyingArray->SetArray(w_allXyzFloatPoints, p_pointCount * 3, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
+	w_vtkPoints->SetData(w_vtkUnderlyingArray);
+	return w_vtkPoints;
+}
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::addGeometryOriginToFieldData(vtkDataObject *p_dataObject) const
+{
+	if (_geometryPrecision == GeometryPrecision::Double || _geometryOrigin == nullptr || std::isnan((*_geometryOrigin)[0]) || p_dataObject == nullptr)
+	{
+		return;
+	}
+
+	vtkSmartPointer<vtkDoubleArray> w_originArray = vtkSmartPointer<vtkDoubleArray>::New();
+	w_originArray->SetName("GeometryOrigin");
+	w_originArray->SetNumberOfComponents(3);
+	w_originArray->InsertNextTuple(_geometryOrigin->data());
+	p_dataObject->GetFieldData()->AddArray(w_originArray);
+}
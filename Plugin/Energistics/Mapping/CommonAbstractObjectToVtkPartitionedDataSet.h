@@ -20,15 +20,20 @@ under the License.
 #define __CommonAbstractObjectTovtkPartitionedDataSet__h__
 
 // include system
+#include <array>
+#include <memory>
 #include <string>
 
 // include VTK library
 #include <vtkSmartPointer.h>
 #include <vtkPartitionedDataSet.h>
+#include <vtkPoints.h>
 
 // include F2i-consulting Energistics Standards API
 #include <fesapi/common/AbstractObject.h>
 
+#include "../Tools/enum.h"
+
 /** @brief	transform a RESQML abstract object to vtkPartitionedDataSet
  */
 class CommonAbstractObjectToVtkPartitionedDataSet
@@ -60,9 +65,38 @@ public:
 	void setUuid(const std::string& p_newUuid) {  _absUuid = p_newUuid; }
 	void setTitle(const std::string& p_newTitle) { _absTitle = p_newTitle; }
 
+	/**
+	 * Set the precision of the VTK points to build. It must be set before loading the VTK object.
+	 *
+	 * @param p_precision	The precision of the VTK points.
+	 * @param p_origin		In float precision, the origin which the points are relative to. It is shared by all the mappers of a same collection
+	 *						in order to keep them aligned. The repository initializes it the same way on all the processes before loading the mappers.
+	 *						If it is still NaN, it is initialized with the first point built by a mapper.
+	 */
+	void setGeometryPrecision(GeometryPrecision p_precision, const std::shared_ptr<std::array<double, 3>> &p_origin);
+
 protected:
 	const COMMON_NS::AbstractObject* getResqmlData() const { return _resqmlData; }
 
+	/**
+	 * Create VTK points in the geometry precision of this mapper.
+	 *
+	 * @param p_allXyzPoints	The XYZ coordinates in the VTK global frame (z flipped if needed). The mapper takes ownership of this array (which must have been allocated with new[]).
+	 * @param p_pointCount		The count of points in p_allXyzPoints.
+	 */
+	vtkSmartPointer<vtkPoints> createVtkPoints(double *p_allXyzPoints, uint64_t p_pointCount);
+
+	/**
+	 * @return the origin to subtract to the points before storing them in VTK. It is the zero vector in double precision.
+	 * @param p_xyzPoint	The point used to initialize the shared origin if it is not initialized yet.
+	 */
+	std::array<double, 3> getGeometryOrigin(const double *p_xyzPoint);
+
+	/**
+	 * Record the geometry origin in the field data of a VTK data object. Does nothing in double precision.
+	 */
+	void addGeometryOriginToFieldData(vtkDataObject *p_dataObject) const;
+
 	uint32_t _procNumber;
 	uint32_t _maxProc;
 
@@ -71,6 +105,9 @@ protected:
 	std::string _absUuid;
 	std::string _absTitle;
 
+	GeometryPrecision _geometryPrecision;
+	std::shared_ptr<std::array<double, 3>> _geometryOrigin;
+
 private:
 	const COMMON_NS::AbstractObject* _resqmlData;
 };
@@ -20,11 +20,16 @@ under the License.
 
 #include <algorithm>
 #include <array>
+#include <functional>
+#include <mutex>
 
 // include VTK library
+#include <vtkCellArray.h>
 #include <vtkCellData.h>
 #include <vtkDataSet.h>
+#include <vtkIdTypeArray.h>
 #include <vtkPointData.h>
+#include <vtkSMPTools.h>
 
 // FESAPI
 #include <fesapi/resqml2/AbstractValuesProperty.h>
@@ -33,6 +38,24 @@ under the License.
 // include F2i-consulting Energistics Paraview Plugin
 #include "Mapping/ResqmlPropertyToVtkDataArray.h"
 
+namespace
+{
+	/**
+	 * Replace some sorted node indices by their position in the kept nodes.
+	 */
+	template <typename T>
+	void toKeptNodeIndices(T *nodeIndices, vtkIdType nodeIndexCount, const std::vector<uint64_t> &keptNodes)
+	{
+		vtkSMPTools::For(0, nodeIndexCount, [nodeIndices, &keptNodes](vtkIdType indexBegin, vtkIdType indexEnd)
+						 {
+							 for (vtkIdType index = indexBegin; index < indexEnd; ++index)
+							 {
+								 nodeIndices[index] = static_cast<T>(std::lower_bound(keptNodes.begin(), keptNodes.end(), static_cast<uint64_t>(nodeIndices[index])) - keptNodes.begin());
+							 }
+						 });
+	}
+}
+
 //----------------------------------------------------------------------------
 ResqmlAbstractRepresentationToVtkPartitionedDataSet::ResqmlAbstractRepresentationToVtkPartitionedDataSet(const RESQML2_NS::AbstractRepresentation *p_abstractRepresentation, uint32_t p_procNumber, uint32_t p_maxProc)
 	: CommonAbstractObjectToVtkPartitionedDataSet(p_abstractRepresentation,
@@ -40,35 +63,43 @@ ResqmlAbstractRepresentationToVtkPartitionedDataSet::ResqmlAbstractRepresentatio
 												  p_maxProc),
 	  _subrepPointerOnPointsCount(0),
 	  _resqmlData(p_abstractRepresentation),
-	  _uuidToVtkDataArray()
+	  _uuidToVtkDataArray(),
+	  _lifetime(std::make_shared<bool>(true))
 {
 }
 
-void ResqmlAbstractRepresentationToVtkPartitionedDataSet::addDataArray(const std::string &p_uuid, uint32_t p_patchIndex)
+ResqmlAbstractRepresentationToVtkPartitionedDataSet::~ResqmlAbstractRepresentationToVtkPartitionedDataSet()
 {
-	std::vector<RESQML2_NS::AbstractValuesProperty *> w_valuesPropertySet = getResqmlData()->getValuesPropertySet();
-	std::vector<RESQML2_NS::AbstractValuesProperty *>::iterator w_it = std::find_if(w_valuesPropertySet.begin(), w_valuesPropertySet.end(),
-																					[&p_uuid](RESQML2_NS::AbstractValuesProperty const *w_property)
-																					{ return w_property->getUuid() == p_uuid; });
-	if (w_it != std::end(w_valuesPropertySet))
+	// Wait for the deferred array being loaded, if any, before the other ones stop reading
+	std::lock_guard<std::recursive_mutex> w_readLock(ResqmlPropertyToVtkDataArray::getReadMutex());
+	_lifetime.reset();
+}
+
+void ResqmlAbstractRepresentationToVtkPartitionedDataSet::addDataArray(const std::string &p_uuid, uint32_t p_patchIndex, vtkSmartPointer<vtkDataArray> p_values)
+{
+	auto const *const w_resqmlProp = findValuesProperty(p_uuid);
+	if (w_resqmlProp != nullptr)
 	{
-		auto const *const w_resqmlProp = *w_it;
-		ResqmlPropertyToVtkDataArray *w_fesppProperty = _isHyperslabed
-														  ? new ResqmlPropertyToVtkDataArray(w_resqmlProp,
-																							 _iCellCount * _jCellCount * (_maxKIndex - _initKIndex),
-																							 _pointCount,
-																							 _iCellCount,
-																							 _jCellCount,
-																							 _maxKIndex - _initKIndex,
-																							 _initKIndex,
-																							 p_patchIndex)
-														  : new ResqmlPropertyToVtkDataArray(w_resqmlProp,
-																							 _iCellCount * _jCellCount * _kCellCount,
-																							 _pointCount,
-																							 p_patchIndex);
+		uint64_t w_tupleCount = 0;
+		std::function<vtkSmartPointer<vtkDataArray>()> w_loader = createDataArrayLoader(w_resqmlProp, p_patchIndex, w_tupleCount);
+		if (p_values != nullptr)
+		{
+			w_loader = [p_values]()
+			{ return p_values; };
+		}
+		else
+		{
+			// A deferred array may be accessed after the deletion of this mapper and of the repository owning the property
+			const std::weak_ptr<bool> w_lifetime = _lifetime;
+			w_loader = [w_loader, w_lifetime]() -> vtkSmartPointer<vtkDataArray>
+			{ return w_lifetime.expired() ? nullptr : w_loader(); };
+		}
+		ResqmlPropertyToVtkDataArray *w_fesppProperty = new ResqmlPropertyToVtkDataArray(w_resqmlProp, w_tupleCount, w_loader, _deferredPropertyLoading);
 		switch (w_resqmlProp->getAttachmentKind())
 		{
 		case gsoap_eml2_3::eml23__IndexableElement::cells:
+			_vtkData->GetPartition(0)->GetCellData()->AddArray(w_fesppProperty->getVtkData());
+			break;
 		case gsoap_eml2_3::eml23__IndexableElement::triangles:
 			_vtkData->GetPartition(0)->GetCellData()->AddArray(w_fesppProperty->getVtkData());
 			break;
@@ -87,6 +118,62 @@ void ResqmlAbstractRepresentationToVtkPartitionedDataSet::addDataArray(const std
 	}
 }
 
+std::function<vtkSmartPointer<vtkDataArray>()> ResqmlAbstractRepresentationToVtkPartitionedDataSet::getDataArrayLoader(const std::string &p_uuid, uint32_t p_patchIndex) const
+{
+	auto const *const w_resqmlProp = findValuesProperty(p_uuid);
+	if (w_resqmlProp == nullptr)
+	{
+		throw std::invalid_argument("The property " + p_uuid + "cannot be read since it is not contained in the representation " + getResqmlData()->getUuid());
+	}
+	uint64_t w_tupleCount = 0;
+	return createDataArrayLoader(w_resqmlProp, p_patchIndex, w_tupleCount);
+}
+
+RESQML2_NS::AbstractValuesProperty *ResqmlAbstractRepresentationToVtkPartitionedDataSet::findValuesProperty(const std::string &p_uuid) const
+{
+	std::vector<RESQML2_NS::AbstractValuesProperty *> w_valuesPropertySet = getResqmlData()->getValuesPropertySet();
+	std::vector<RESQML2_NS::AbstractValuesProperty *>::iterator w_it = std::find_if(w_valuesPropertySet.begin(), w_valuesPropertySet.end(),
+																					[&p_uuid](RESQML2_NS::AbstractValuesProperty const *w_property)
+																					{ return w_property->getUuid() == p_uuid; });
+	return w_it != std::end(w_valuesPropertySet) ? *w_it : nullptr;
+}
+
+std::function<vtkSmartPointer<vtkDataArray>()> ResqmlAbstractRepresentationToVtkPartitionedDataSet::createDataArrayLoader(RESQML2_NS::AbstractValuesProperty const *p_resqmlProp, uint32_t p_patchIndex, uint64_t &p_tupleCount) const
+{
+	static const std::vector<uint64_t> w_allTuples;
+	// The RESQML index of each VTK tuple, empty if they are all the RESQML elements in the same order
+	const std::vector<uint64_t> &w_keptTuples = p_resqmlProp->getAttachmentKind() == gsoap_eml2_3::eml23__IndexableElement::cells
+													? _vtkCellToResqmlCell
+													: (p_resqmlProp->getAttachmentKind() == gsoap_eml2_3::eml23__IndexableElement::nodes ? _vtkPointToResqmlPoint : w_allTuples);
+	const uint64_t w_cellCount = _isHyperslabed
+									 ? static_cast<uint64_t>(_maxIIndex - _initIIndex) * (_maxJIndex - _initJIndex) * (_maxKIndex - _initKIndex)
+									 : static_cast<uint64_t>(_iCellCount) * _jCellCount * _kCellCount;
+	p_tupleCount = !w_keptTuples.empty()
+					   ? w_keptTuples.size()
+					   : (p_resqmlProp->getAttachmentKind() == gsoap_eml2_3::eml23__IndexableElement::nodes ? _pointCount : w_cellCount);
+
+	// The loader copies what it needs of this mapper, which may be deleted before a deferred loading
+	// The cell properties are read by block, the node ones by the kept tuples since the nodes of a block are not a block of the nodes.
+	const bool w_isHyperslabed = _isHyperslabed && p_resqmlProp->getAttachmentKind() == gsoap_eml2_3::eml23__IndexableElement::cells;
+	const uint64_t w_pointCount = _pointCount;
+	const std::array<uint32_t, 8> w_block = {{_iCellCount, _jCellCount, _maxIIndex - _initIIndex, _maxJIndex - _initJIndex, _maxKIndex - _initKIndex, _initIIndex, _initJIndex, _initKIndex}};
+	const std::vector<uint64_t> w_loadedTuples = w_keptTuples;
+	const uint64_t w_maxReadBufferSize = _maxReadBufferSize;
+	return [p_resqmlProp, w_isHyperslabed, w_cellCount, w_pointCount, w_block, w_loadedTuples, p_patchIndex, w_maxReadBufferSize]() -> vtkSmartPointer<vtkDataArray>
+	{
+		if (w_isHyperslabed)
+		{
+			ResqmlPropertyToVtkDataArray w_property(p_resqmlProp, w_cellCount, w_pointCount, w_block[0], w_block[1], w_block[2], w_block[3], w_block[4], w_block[5], w_block[6], w_block[7], p_patchIndex, w_maxReadBufferSize);
+			if (!w_loadedTuples.empty())
+			{
+				w_property.keepTuples(w_loadedTuples);
+			}
+			return w_property.getVtkData();
+		}
+		return ResqmlPropertyToVtkDataArray(p_resqmlProp, w_cellCount, w_pointCount, p_patchIndex, w_loadedTuples, w_maxReadBufferSize).getVtkData();
+	};
+}
+
 void ResqmlAbstractRepresentationToVtkPartitionedDataSet::deleteDataArray(const std::string &p_uuid)
 {
 	ResqmlPropertyToVtkDataArray *w_vtkDataArray = _uuidToVtkDataArray[p_uuid];
@@ -112,6 +199,12 @@ void ResqmlAbstractRepresentationToVtkPartitionedDataSet::deleteDataArray(const
 	}
 }
 
+ResqmlPropertyToVtkDataArray *ResqmlAbstractRepresentationToVtkPartitionedDataSet::getDataArray(const std::string &p_uuid) const
+{
+	const auto w_it = _uuidToVtkDataArray.find(p_uuid);
+	return w_it != _uuidToVtkDataArray.end() ? w_it->second : nullptr;
+}
+
 void ResqmlAbstractRepresentationToVtkPartitionedDataSet::registerSubRep()
 {
 	++_subrepPointerOnPointsCount;
@@ -126,3 +219,94 @@ unsigned int ResqmlAbstractRepresentationToVtkPartitionedDataSet::subRepLinkedCo
 {
 	return _subrepPointerOnPointsCount;
 }
+
+void ResqmlAbstractRepresentationToVtkPartitionedDataSet::setReferencedPoints(vtkCellArray *p_cells)
+{
+	if (p_cells->IsStorage64Bit())
+	{
+		vtkCellArray::ArrayType64 *connectivity = p_cells->GetConnectivityArray64();
+		_vtkPointToResqmlPoint.assign(connectivity->GetPointer(0), connectivity->GetPointer(0) + connectivity->GetNumberOfValues());
+	}
+	else
+	{
+		vtkCellArray::ArrayType32 *connectivity = p_cells->GetConnectivityArray32();
+		_vtkPointToResqmlPoint.assign(connectivity->GetPointer(0), connectivity->GetPointer(0) + connectivity->GetNumberOfValues());
+	}
+	std::sort(_vtkPointToResqmlPoint.begin(), _vtkPointToResqmlPoint.end());
+	_vtkPointToResqmlPoint.erase(std::unique(_vtkPointToResqmlPoint.begin(), _vtkPointToResqmlPoint.end()), _vtkPointToResqmlPoint.end());
+}
+
+void ResqmlAbstractRepresentationToVtkPartitionedDataSet::compactPointIds(vtkCellArray *p_cells) const
+{
+	// The RESQML node indices are replaced by their index in the kept nodes.
+	const std::vector<uint64_t> &keptNodes = _vtkPointToResqmlPoint;
+	if (p_cells->IsStorage64Bit())
+	{
+		vtkCellArray::ArrayType64 *connectivity = p_cells->GetConnectivityArray64();
+		toKeptNodeIndices(connectivity->GetPointer(0), connectivity->GetNumberOfValues(), keptNodes);
+	}
+	else
+	{
+		vtkCellArray::ArrayType32 *connectivity = p_cells->GetConnectivityArray32();
+		toKeptNodeIndices(connectivity->GetPointer(0), connectivity->GetNumberOfValues(), keptNodes);
+	}
+}
+
+void ResqmlAbstractRepresentationToVtkPartitionedDataSet::compactPointIds(vtkUnstructuredGrid *p_unstructuredGrid) const
+{
+	compactPointIds(p_unstructuredGrid->GetCells());
+
+	const std::vector<uint64_t> &keptNodes = _vtkPointToResqmlPoint;
+	// The faces of the polyhedra : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...) for each polyhedron
+	vtkIdTypeArray *faces = p_unstructuredGrid->GetFaces();
+	if (faces != nullptr)
+	{
+		vtkIdType *faceStream = faces->GetPointer(0);
+		vtkIdType *const faceStreamEnd = faceStream + faces->GetNumberOfValues();
+		while (faceStream != faceStreamEnd)
+		{
+			const vtkIdType faceCount = *faceStream++;
+			for (vtkIdType faceIndex = 0; faceIndex < faceCount; ++faceIndex)
+			{
+				const vtkIdType faceNodeCount = *faceStream++;
+				for (vtkIdType faceNodeIndex = 0; faceNodeIndex < faceNodeCount; ++faceNodeIndex, ++faceStream)
+				{
+					*faceStream = std::lower_bound(keptNodes.begin(), keptNodes.end(), static_cast<uint64_t>(*faceStream)) - keptNodes.begin();
+				}
+			}
+		}
+	}
+}
+
+void ResqmlAbstractRepresentationToVtkPartitionedDataSet::keepReferencedPointsOnly(vtkUnstructuredGrid *p_unstructuredGrid, vtkPoints *p_points)
+{
+	setReferencedPoints(p_unstructuredGrid->GetCells());
+	compactPointIds(p_unstructuredGrid);
+
+	const vtkIdType keptPointCount = _vtkPointToResqmlPoint.size();
+	vtkSmartPointer<vtkPoints> keptPoints = vtkSmartPointer<vtkPoints>::New();
+	keptPoints->SetDataType(p_points->GetDataType());
+	keptPoints->SetNumberOfPoints(keptPointCount);
+	vtkDataArray *keptXyz = keptPoints->GetData();
+	vtkDataArray *allXyz = p_points->GetData();
+	const std::vector<uint64_t> &keptNodes = _vtkPointToResqmlPoint;
+	vtkSMPTools::For(0, keptPointCount, [keptXyz, allXyz, &keptNodes](vtkIdType pointBegin, vtkIdType pointEnd)
+					 {
+						 for (vtkIdType pointIndex = pointBegin; pointIndex < pointEnd; ++pointIndex)
+						 {
+							 keptXyz->SetTuple(pointIndex, keptNodes[pointIndex], allXyz);
+						 }
+					 });
+	p_unstructuredGrid->SetPoints(keptPoints);
+
+	addOriginalPointIds(p_unstructuredGrid);
+}
+
+void ResqmlAbstractRepresentationToVtkPartitionedDataSet::addOriginalPointIds(vtkDataSet *p_dataSet) const
+{
+	vtkSmartPointer<vtkIdTypeArray> originalPointIds = vtkSmartPointer<vtkIdTypeArray>::New();
+	originalPointIds->SetName("vtkOriginalPointIds");
+	originalPointIds->SetNumberOfValues(_vtkPointToResqmlPoint.size());
+	std::copy(_vtkPointToResqmlPoint.begin(), _vtkPointToResqmlPoint.end(), originalPointIds->GetPointer(0));
+	p_dataSet->GetPointData()->AddArray(originalPointIds);
+}
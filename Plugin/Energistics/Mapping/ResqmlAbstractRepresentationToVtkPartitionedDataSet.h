@@ -20,11 +20,17 @@ under the License.
 #define __ResqmlAbstractRepresentationTovtkPartitionedDataSet__h__
 
 // include system
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 // include VTK library
 #include <vtkSmartPointer.h>
+#include <vtkDataArray.h>
 #include <vtkPartitionedDataSet.h>
+#include <vtkPoints.h>
+#include <vtkUnstructuredGrid.h>
 
 // include F2i-consulting Energistics Standards API
 #include <fesapi/resqml2/AbstractRepresentation.h>
@@ -32,6 +38,8 @@ under the License.
 // include F2i-consulting Energistics Standards Paraview Plugin
 #include "CommonAbstractObjectToVtkPartitionedDataSet.h"
 
+class vtkCellArray;
+
 /** @brief	transform a RESQML abstract representation to vtkPartitionedDataSet
  */
 class ResqmlAbstractRepresentationToVtkPartitionedDataSet : public CommonAbstractObjectToVtkPartitionedDataSet
@@ -43,9 +51,9 @@ public:
 	ResqmlAbstractRepresentationToVtkPartitionedDataSet(const RESQML2_NS::AbstractRepresentation *p_abstractRepresentation, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1);
 
 	/**
-	 * Destructor
+	 * Destructor : the deferred arrays of this mapper which are not loaded yet can no longer read their values.
 	 */
-	virtual ~ResqmlAbstractRepresentationToVtkPartitionedDataSet() = default;
+	virtual ~ResqmlAbstractRepresentationToVtkPartitionedDataSet();
 
 	/**
 	 * load VtkPartitionedDataSet with resqml data
@@ -54,14 +62,36 @@ public:
 
 	/**
 	 * add a resqml property to VtkPartitionedDataSet
+	 *
+	 * @param p_values	The values already returned by the loader of this property, if any, else they are read.
+	 */
+	void addDataArray(const std::string &p_uuid, uint32_t p_patchIndex = 0, vtkSmartPointer<vtkDataArray> p_values = nullptr);
+
+	/**
+	 * @return a function reading the values of a resqml property as addDataArray does, which can be called later by another thread, even after the deletion of this mapper
+	 */
+	std::function<vtkSmartPointer<vtkDataArray>()> getDataArrayLoader(const std::string &p_uuid, uint32_t p_patchIndex = 0) const;
+
+	/**
+	 * Cap the size in bytes of the temporary buffers of the partial reads of the properties added afterwards.
+	 */
+	void setMaxReadBufferSize(uint64_t p_byteCount) { _maxReadBufferSize = p_byteCount; }
+
+	/**
+	 * Defer the reading of the values of the properties added afterwards until a filter accesses them.
 	 */
-	void addDataArray(const std::string &p_uuid, uint32_t p_patchIndex = 0);
+	void setDeferredPropertyLoading(bool p_deferred) { _deferredPropertyLoading = p_deferred; }
 
 	/**
 	 * remove a resqml property to VtkPartitionedDataSet
 	 */
 	void deleteDataArray(const std::string &p_uuid);
 
+	/**
+	 * @return the property added with this UUID, nullptr if it has not been added
+	 */
+	class ResqmlPropertyToVtkDataArray *getDataArray(const std::string &p_uuid) const;
+
 	/**
 	 *
 	 */
@@ -72,19 +102,70 @@ public:
 protected:
 	const RESQML2_NS::AbstractRepresentation *getResqmlData() const { return _resqmlData; }
 
+	/**
+	 * Record in _vtkPointToResqmlPoint the sorted RESQML node indices referenced by some cells, whose point ids are RESQML node indices.
+	 */
+	void setReferencedPoints(vtkCellArray *p_cells);
+
+	/**
+	 * Replace the RESQML node indices of the cells by the indices of the VTK points, which only are the nodes listed in _vtkPointToResqmlPoint.
+	 */
+	void compactPointIds(vtkCellArray *p_cells) const;
+	void compactPointIds(vtkUnstructuredGrid *p_unstructuredGrid) const;
+
+	/**
+	 * Add to a dataset the vtkOriginalPointIds point data array, which is the RESQML node index of each VTK point listed in _vtkPointToResqmlPoint.
+	 */
+	void addOriginalPointIds(vtkDataSet *p_dataSet) const;
+
+	/**
+	 * Only keep the points referenced by the cells of an unstructured grid, whose point ids are RESQML node indices.
+	 * The original index of each kept point is recorded in _vtkPointToResqmlPoint and in the vtkOriginalPointIds point data array.
+	 *
+	 * @param p_points	All the points of the RESQML representation, indexed by RESQML node index.
+	 */
+	void keepReferencedPointsOnly(vtkUnstructuredGrid *p_unstructuredGrid, vtkPoints *p_points);
+
+	/**
+	 * @return the resqml property of this representation with this UUID, nullptr if there is none
+	 */
+	RESQML2_NS::AbstractValuesProperty *findValuesProperty(const std::string &p_uuid) const;
+
+	/**
+	 * @param p_tupleCount	Set to the count of tuples of the VTK array.
+	 * @return a function reading the values of a resqml property for the piece of this mapper
+	 */
+	std::function<vtkSmartPointer<vtkDataArray>()> createDataArrayLoader(RESQML2_NS::AbstractValuesProperty const *p_resqmlProp, uint32_t p_patchIndex, uint64_t &p_tupleCount) const;
+
 	uint32_t _subrepPointerOnPointsCount;
 
 	uint64_t _pointCount = 0;
 	uint32_t _iCellCount = 0; // = cellcount if not ijkGrid
 	uint32_t _jCellCount = 1;
 	uint32_t _kCellCount = 1;
+	uint32_t _initIIndex = 0;
+	uint32_t _maxIIndex = 0;
+	uint32_t _initJIndex = 0;
+	uint32_t _maxJIndex = 0;
 	uint32_t _initKIndex = 0;
 	uint32_t _maxKIndex = 0;
 
 	bool _isHyperslabed = false;
 
+	// RESQML cell index of each VTK cell. Empty if the VTK cells are all the RESQML cells, in the same order.
+	std::vector<uint64_t> _vtkCellToResqmlCell;
+	// RESQML node index of each VTK point. Empty if the VTK points are all the RESQML nodes, in the same order.
+	std::vector<uint64_t> _vtkPointToResqmlPoint;
+
 	const RESQML2_NS::AbstractRepresentation *_resqmlData;
 
 	std::unordered_map<std::string, class ResqmlPropertyToVtkDataArray *> _uuidToVtkDataArray;
+
+	// The cap of the temporary buffers of the partial reads of the properties, given by the repository
+	uint64_t _maxReadBufferSize = 256 * 1024 * 1024;
+	bool _deferredPropertyLoading = false;
+
+	// Expires with the mapper : the loaders of the deferred arrays hold a weak pointer to it since the RESQML properties may be deleted with the repository.
+	std::shared_ptr<bool> _lifetime;
 };
 #endif
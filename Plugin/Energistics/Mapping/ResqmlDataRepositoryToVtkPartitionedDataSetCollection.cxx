@@ -33,10 +33,13 @@ VtkAssembly => TreeView:
 #include <vector>
 #include <set>
 #include <list>
+#include <iterator>
 #include <regex>
 #include <numeric>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <cmath>
 
 // VTK includes
 #include <vtkPartitionedDataSetCollection.h>
@@ -44,6 +47,8 @@ VtkAssembly => TreeView:
 #include <vtkInformation.h>
 #include <vtkDataAssembly.h>
 #include <vtkDataArraySelection.h>
+#include <vtkFieldData.h>
+#include <vtkSMPTools.h>
 
 // FESAPI includes
 #include <fesapi/common/DataObjectRepository.h>
@@ -52,6 +57,7 @@ VtkAssembly => TreeView:
 #include <fesapi/resqml2/Grid2dRepresentation.h>
 #include <fesapi/resqml2/AbstractFeatureInterpretation.h>
 #include <fesapi/resqml2/AbstractIjkGridRepresentation.h>
+#include <fesapi/resqml2/AbstractLocal3dCrs.h>
 #include <fesapi/resqml2/PolylineSetRepresentation.h>
 #include <fesapi/resqml2/SubRepresentation.h>
 #include <fesapi/resqml2/TriangulatedSetRepresentation.h>
@@ -94,30 +100,43 @@ VtkAssembly => TreeView:
 #include "Mapping/WitsmlWellboreCompletionToVtkPartitionedDataSet.h"
 #include "Mapping/WitsmlWellboreCompletionPerforationToVtkPolyData.h"
 #include "Mapping/CommonAbstractObjectSetToVtkPartitionedDataSetSet.h"
+#include "Mapping/ResqmlPropertyToVtkDataArray.h"
 
 ResqmlDataRepositoryToVtkPartitionedDataSetCollection::ResqmlDataRepositoryToVtkPartitionedDataSetCollection()
     : _markerOrientation(false),
       _markerSize(10),
+      _threadCount(0),
+      _propertyReadMemoryLimit(256),
+      _deferredPropertyLoading(false),
+      _timeStepPrefetchWindow(1),
+      _geometryPrecision(GeometryPrecision::Double),
+      _ijkPartitioning(IjkPartitioning::EqualK),
+      _ghostCellLayer(false),
+      _subRepPointCompaction(false),
+      _geometryOrigin(std::make_shared<std::array<double, 3>>()),
       _repository(new common::DataObjectRepository()),
       _output(vtkSmartPointer<vtkPartitionedDataSetCollection>::New()),
       _nodeIdToMapper(),
+      _nodeNameToNodeId(),
+      _nodeInfos(1), // the root
+      _timeSeriesPrefetcher(4 * (_timeStepPrefetchWindow + 1)),
       _currentSelection(),
-      _oldSelection()
+      _loadedSelection(),
+      _loadedTime(std::numeric_limits<double>::quiet_NaN())
 {
     auto w_assembly = vtkSmartPointer<vtkDataAssembly>::New();
     w_assembly->SetRootNodeName("data");
 
     _output->SetDataAssembly(w_assembly);
     _timesStep.clear();
+    _geometryOrigin->fill(std::numeric_limits<double>::quiet_NaN());
 }
 
 ResqmlDataRepositoryToVtkPartitionedDataSetCollection::~ResqmlDataRepositoryToVtkPartitionedDataSetCollection()
 {
+    // no step may be read once the repository is deleted, nor any deferred array of the mappers
+    clearMappers();
     delete _repository;
-    for (const auto &w_keyVal : _nodeIdToMapper)
-    {
-        delete w_keyVal.second;
-    }
 }
 
 MapperType getMapperType(TreeViewNodeType p_type)
@@ -202,6 +221,53 @@ std::string SimplifyXmlTag(std::string p_typeRepresentation)
     return p_typeRepresentation;
 }
 
+// The XML tag of the mapped class from which a data object derives, for the classes which have no mapper of their own (for instance a seismic wellbore frame).
+// The classes are tried in the order of the most derived ones first. Empty if the data object is not mapped.
+std::string GetMappedBaseXmlTag(COMMON_NS::AbstractObject const *p_object)
+{
+    if (dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::AbstractIjkGridRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::Grid2dRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::Grid2dRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::TriangulatedSetRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::TriangulatedSetRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::PolylineSetRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::PolylineSetRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::UnstructuredGridRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::UnstructuredGridRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::SubRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::SubRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::WellboreTrajectoryRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::WellboreTrajectoryRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::WellboreMarkerFrameRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::WellboreMarkerFrameRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<RESQML2_NS::WellboreFrameRepresentation const *>(p_object) != nullptr)
+    {
+        return RESQML2_NS::WellboreFrameRepresentation::XML_TAG;
+    }
+    if (dynamic_cast<witsml2_1::WellboreCompletion const *>(p_object) != nullptr)
+    {
+        return witsml2_1::WellboreCompletion::XML_TAG;
+    }
+    return std::string();
+}
+
 //----------------------------------------------------------------------------
 std::vector<std::string> ResqmlDataRepositoryToVtkPartitionedDataSetCollection::connect(const std::string &p_etpUrl, const std::string &p_dataPartition, const std::string &p_authConnection)
 {
@@ -301,6 +367,9 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::disconnect()
 //----------------------------------------------------------------------------
 std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addFile(const char *p_fileName)
 {
+    ResqmlTimeSeriesPrefetcher::ScopedPause w_pause(_timeSeriesPrefetcher);
+    // the steps already read may be replaced by the objects of the new file
+    _timeSeriesPrefetcher.clear();
 
     COMMON_NS::EpcDocument w_pck(p_fileName);
     std::string w_message = w_pck.deserializeInto(*_repository);
@@ -313,6 +382,8 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addFile(const
 //----------------------------------------------------------------------------
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::closeFiles()
 {
+    // called after each request : the cached steps are kept for the next ones
+    ResqmlTimeSeriesPrefetcher::ScopedPause w_pause(_timeSeriesPrefetcher);
     for (const std::string w_filename : _files)
     {
         COMMON_NS::EpcDocument w_pck(w_filename);
@@ -323,6 +394,7 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::closeFiles()
 //----------------------------------------------------------------------------
 std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataspace(const char *p_dataspace)
 {
+    ResqmlTimeSeriesPrefetcher::ScopedPause w_pause(_timeSeriesPrefetcher);
 #ifdef WITH_ETP_SSL
     //************ LIST RESOURCES ************
     Energistics::Etp::v12::Datatypes::Object::ContextInfo w_ctxInfo;
@@ -407,7 +479,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchReprese
     {
         // check if it has already been added
         // not exist => not loaded
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_representation->getUuid()).c_str()) == -1)
+        if (findNode("_" + p_representation->getUuid()) == -1)
         {
             return "Partial representation with UUID \"" + p_representation->getUuid() + "\" is not loaded.\n";
         } /******* TODO ********/ // exist but not the same type ?
@@ -416,10 +488,10 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchReprese
     {
         // The leading underscore is forced by VTK which does not support a node name starting with a digit (probably because it is a QNAME).
         const std::string w_nodeName = "_" + p_representation->getUuid();
-        const uint32_t w_existingNodeId = _output->GetDataAssembly()->FindFirstNodeWithName(w_nodeName.c_str());
+        const uint32_t w_existingNodeId = findNode(w_nodeName);
         if (w_existingNodeId == -1)
         {
-            p_NodeId = _output->GetDataAssembly()->AddNode(w_nodeName.c_str(), p_NodeId);
+            p_NodeId = addNode(w_nodeName, p_NodeId);
 
             auto const *w_subrep = dynamic_cast<RESQML2_NS::SubRepresentation const *>(p_representation);
             // To shorten the xmlTag by removing �Representation� from the end.
@@ -435,7 +507,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchReprese
                                                 : TreeViewNodeType::SubRepresentation;
 
             _output->GetDataAssembly()->SetAttribute(p_NodeId, "label", w_representationVtkValidName.c_str());
-            _output->GetDataAssembly()->SetAttribute(p_NodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Representation)).c_str());
+            setNodeType(p_NodeId, w_type);
         }
         else
         {
@@ -480,7 +552,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchSubRepr
 
 int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchPropertySet(resqml2_0_1::PropertySet const *p_propSet, uint32_t p_nodeId)
 {
-    if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_propSet->getUuid()).c_str()) == -1)
+    if (findNode("_" + p_propSet->getUuid()) == -1)
     { // verify uuid exist in treeview
       // To shorten the xmlTag by removing �Representation� from the end.
         resqml2_0_1::PropertySet *w_parent = p_propSet->getParent();
@@ -488,17 +560,17 @@ int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchPropertySet(res
         {
             p_nodeId = searchPropertySet(w_parent, p_nodeId);
         }
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_propSet->getUuid()).c_str()) == -1)
+        if (findNode("_" + p_propSet->getUuid()) == -1)
         {
             const std::string w_vtkValidName = MakeValidNodeName(("Collection_" + p_propSet->getTitle()).c_str());
-            p_nodeId = _output->GetDataAssembly()->AddNode(("_" + p_propSet->getUuid()).c_str(), p_nodeId);
+            p_nodeId = addNode("_" + p_propSet->getUuid(), p_nodeId);
             _output->GetDataAssembly()->SetAttribute(p_nodeId, "label", w_vtkValidName.c_str());
-            _output->GetDataAssembly()->SetAttribute(p_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Collection)).c_str());
+            setNodeType(p_nodeId, TreeViewNodeType::Collection);
         }
     }
     else
     {
-        return _output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_propSet->getUuid()).c_str());
+        return findNode("_" + p_propSet->getUuid());
     }
 
     return p_nodeId;
@@ -522,11 +594,11 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchPropert
 
             const std::string w_vtkValidName = MakeValidNodeName((w_property->getXmlTag() + '_' + w_property->getTitle()).c_str());
 
-            if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_property->getUuid()).c_str()) == -1)
+            if (findNode("_" + w_property->getUuid()) == -1)
             { // verify uuid exist in treeview
-                uint32_t w_propertyNodeId = _output->GetDataAssembly()->AddNode(("_" + w_property->getUuid()).c_str(), w_propertySetNodeId);
+                uint32_t w_propertyNodeId = addNode("_" + w_property->getUuid(), w_propertySetNodeId);
                 _output->GetDataAssembly()->SetAttribute(w_propertyNodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_propertyNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Properties)).c_str());
+                setNodeType(w_propertyNodeId, TreeViewNodeType::Properties);
             }
         }
     }
@@ -540,24 +612,24 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchPropert
 
 int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchRepresentationSetRepresentation(resqml2::RepresentationSetRepresentation const *p_rsr, uint32_t p_nodeId)
 {
-    if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_rsr->getUuid()).c_str()) == -1)
+    if (findNode("_" + p_rsr->getUuid()) == -1)
     { // verify uuid exist in treeview
       // To shorten the xmlTag by removing �Representation� from the end.
         for (resqml2::RepresentationSetRepresentation *w_rsr : p_rsr->getRepresentationSetRepresentationSet())
         {
             p_nodeId = searchRepresentationSetRepresentation(w_rsr, p_nodeId);
         }
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_rsr->getUuid()).c_str()) == -1)
+        if (findNode("_" + p_rsr->getUuid()) == -1)
         {
             const std::string w_vtkValidName = this->MakeValidNodeName(("Collection_" + p_rsr->getTitle()).c_str());
-            p_nodeId = _output->GetDataAssembly()->AddNode(("_" + p_rsr->getUuid()).c_str(), p_nodeId);
+            p_nodeId = addNode("_" + p_rsr->getUuid(), p_nodeId);
             _output->GetDataAssembly()->SetAttribute(p_nodeId, "label", w_vtkValidName.c_str());
-            _output->GetDataAssembly()->SetAttribute(p_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Collection)).c_str());
+            setNodeType(p_nodeId, TreeViewNodeType::Collection);
         }
     }
     else
     {
-        return _output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_rsr->getUuid()).c_str());
+        return findNode("_" + p_rsr->getUuid());
     }
     return p_nodeId;
 }
@@ -573,7 +645,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
 
         uint32_t w_nodeId = 0;
         uint32_t w_initNodeId = 0;
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_wellboreTrajectory->getUuid()).c_str()) == -1)
+        if (findNode("_" + w_wellboreTrajectory->getUuid()) == -1)
         { // verify uuid exist in treeview
           // To shorten the xmlTag by removing �Representation� from the end.
             for (resqml2::RepresentationSetRepresentation *w_rsr : w_wellboreTrajectory->getRepresentationSetRepresentationSet())
@@ -581,12 +653,12 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
                 w_initNodeId = searchRepresentationSetRepresentation(w_rsr);
             }
 
-            if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_wellboreFeature->getUuid()).c_str()) == -1)
+            if (findNode("_" + w_wellboreFeature->getUuid()) == -1)
             {
                 const std::string w_vtkValidName = "Wellbore_" + MakeValidNodeName(w_wellboreFeature->getTitle().c_str());
-                w_initNodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreFeature->getUuid()).c_str(), w_initNodeId);
+                w_initNodeId = addNode("_" + w_wellboreFeature->getUuid(), w_initNodeId);
                 _output->GetDataAssembly()->SetAttribute(w_initNodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_initNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Wellbore)).c_str());
+                setNodeType(w_initNodeId, TreeViewNodeType::Wellbore);
             }
 
             if (w_wellboreTrajectory->isPartial())
@@ -595,7 +667,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
 
                 const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreTrajectory->getXmlTag()) + "_" + w_wellboreTrajectory->getTitle()).c_str());
                 // not exist => not loaded
-                if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_vtkValidName).c_str()) == -1)
+                if (findNode("_" + w_vtkValidName) == -1)
                 {
                     w_result = w_result + " Partial UUID: (" + w_wellboreTrajectory->getUuid() + ") is not loaded \n";
                     continue;
@@ -604,9 +676,9 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
             else
             {
                 const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreTrajectory->getXmlTag()) + '_' + w_wellboreTrajectory->getTitle()).c_str());
-                w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreTrajectory->getUuid()).c_str(), w_initNodeId);
+                w_nodeId = addNode("_" + w_wellboreTrajectory->getUuid(), w_initNodeId);
                 _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreTrajectory)).c_str());
+                setNodeType(w_nodeId, TreeViewNodeType::WellboreTrajectory);
             }
         }
         w_result += searchWellboreFrame(w_wellboreTrajectory, w_initNodeId);
@@ -620,36 +692,36 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
     std::string w_result = "";
     for (auto *w_wellboreFrame : p_wellboreTrajectory->getWellboreFrameRepresentationSet())
     {
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_wellboreFrame->getUuid()).c_str()) == -1)
+        if (findNode("_" + w_wellboreFrame->getUuid()) == -1)
         { // verify uuid exist in treeview
           // common with wellboreMarkerFrame & WellboreFrame
             const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreFrame->getXmlTag()) + '_' + w_wellboreFrame->getTitle()).c_str());
-            uint32_t w_frameNodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreFrame->getUuid()).c_str(), p_nodeId);
+            uint32_t w_frameNodeId = addNode("_" + w_wellboreFrame->getUuid(), p_nodeId);
             _output->GetDataAssembly()->SetAttribute(w_frameNodeId, "label", w_vtkValidName.c_str());
 
             auto *w_wellboreMarkerFrame = dynamic_cast<RESQML2_NS::WellboreMarkerFrameRepresentation const *>(w_wellboreFrame);
             if (w_wellboreMarkerFrame == nullptr)
             { // WellboreFrame
-                _output->GetDataAssembly()->SetAttribute(w_frameNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreFrame)).c_str());
+                setNodeType(w_frameNodeId, TreeViewNodeType::WellboreFrame);
                 // chanel
                 for (auto *w_property : w_wellboreFrame->getValuesPropertySet())
                 {
                     const std::string w_vtkValidName = MakeValidNodeName((w_property->getXmlTag() + '_' + w_property->getTitle()).c_str());
-                    uint32_t w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_property->getUuid()).c_str(), w_frameNodeId);
+                    uint32_t w_nodeId = addNode("_" + w_property->getUuid(), w_frameNodeId);
                     _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreChannel)).c_str());
+                    setNodeType(w_nodeId, TreeViewNodeType::WellboreChannel);
                 }
             }
             else
             { // WellboreMarkerFrame
-                _output->GetDataAssembly()->SetAttribute(w_frameNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreMarkerFrame)).c_str());
+                setNodeType(w_frameNodeId, TreeViewNodeType::WellboreMarkerFrame);
                 // marker
                 for (auto *w_wellboreMarker : w_wellboreMarkerFrame->getWellboreMarkerSet())
                 {
                     const std::string w_vtkValidName = MakeValidNodeName((w_wellboreMarker->getXmlTag() + '_' + w_wellboreMarker->getTitle()).c_str());
-                    uint32_t w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreMarker->getUuid()).c_str(), w_frameNodeId);
+                    uint32_t w_nodeId = addNode("_" + w_wellboreMarker->getUuid(), w_frameNodeId);
                     _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreMarker)).c_str());
+                    setNodeType(w_nodeId, TreeViewNodeType::WellboreMarker);
                 }
             }
         }
@@ -668,9 +740,9 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
             for (const auto *w_wellboreCompletion : w_witsmlWellbore->getWellboreCompletionSet())
             {
                 const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreCompletion->getXmlTag()) + '_' + w_wellboreCompletion->getTitle()).c_str());
-                uint32_t w_completionNodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreCompletion->getUuid()).c_str(), p_nodeId);
+                uint32_t w_completionNodeId = addNode("_" + w_wellboreCompletion->getUuid(), p_nodeId);
                 _output->GetDataAssembly()->SetAttribute(w_completionNodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_completionNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreCompletion)).c_str());
+                setNodeType(w_completionNodeId, TreeViewNodeType::WellboreCompletion);
                 // Iterate over the perforations.
                 for (uint64_t w_perforationIndex = 0; w_perforationIndex < w_wellboreCompletion->getConnectionCount(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION); ++w_perforationIndex)
                 {
@@ -726,12 +798,19 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
                     }
                     w_perforationName += "__Skin_" + w_perforationSkin + "__Diam_" + w_perforationDiameter;
 
-                    uint32_t w_nodeId = _output->GetDataAssembly()->AddNode(this->MakeValidNodeName(("_" + w_wellboreCompletion->getUuid() + "_" + w_wellboreCompletion->getConnectionUid(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION, w_perforationIndex)).c_str()).c_str(), w_completionNodeId);
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", MakeValidNodeName((w_perforationName).c_str()).c_str());
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Perforation)).c_str());
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "connection", w_wellboreCompletion->getConnectionUid(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION, w_perforationIndex).c_str());
+                    std::shared_ptr<NodeInfo::Perforation> w_perforation = std::make_shared<NodeInfo::Perforation>();
+                    w_perforation->connection = w_wellboreCompletion->getConnectionUid(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION, w_perforationIndex);
+                    w_perforation->label = MakeValidNodeName((w_perforationName).c_str());
+                    w_perforation->skin = std::strtod(w_perforationSkin.c_str(), nullptr);
+                    w_perforation->diameter = std::strtod(w_perforationDiameter.c_str(), nullptr);
+
+                    uint32_t w_nodeId = addNode(this->MakeValidNodeName(("_" + w_wellboreCompletion->getUuid() + "_" + w_perforation->connection).c_str()), w_completionNodeId);
+                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_perforation->label.c_str());
+                    setNodeType(w_nodeId, TreeViewNodeType::Perforation);
+                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "connection", w_perforation->connection.c_str());
                     _output->GetDataAssembly()->SetAttribute(w_nodeId, "skin", w_perforationSkin.c_str());
                     _output->GetDataAssembly()->SetAttribute(w_nodeId, "diameter", w_perforationDiameter.c_str());
+                    _nodeInfos[w_nodeId].perforation = w_perforation;
                 }
             }
         }
@@ -767,7 +846,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSer
                 if (w_prop->getXmlTag() == RESQML2_NS::ContinuousProperty::XML_TAG ||
                     w_prop->getXmlTag() == RESQML2_NS::DiscreteProperty::XML_TAG)
                 {
-                    auto w_nodeId = (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_prop->getUuid()).c_str()));
+                    auto w_nodeId = findNode("_" + w_prop->getUuid());
                     if (w_nodeId == -1)
                     {
                         w_message = w_message + "The property " + w_prop->getUuid() + " is not supported and consequently cannot be associated to its time series.\n";
@@ -776,7 +855,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSer
                     else
                     {
                         // same node parent else not supported
-                        const uint32_t w_parentNodeId = _output->GetDataAssembly()->GetParent(w_nodeId);
+                        const uint32_t w_parentNodeId = getNodeInfo(w_nodeId).parent;
                         if (w_parentNodeId != -1)
                         {
                             w_propertyNameToNodeIdSet[w_prop->getTitle()].push_back(w_nodeId);
@@ -804,13 +883,13 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSer
                 // erase property add to treeview for group by TimeSerie
                 for (auto node : w_propertyNodeSet)
                 {
-                    w_parentNodeId = _output->GetDataAssembly()->GetParent(node);
-                    _output->GetDataAssembly()->RemoveNode(node);
+                    w_parentNodeId = getNodeInfo(node).parent;
+                    removeNode(node);
                 }
                 std::string w_vtkValidName = MakeValidNodeName((w_timeSeries->getXmlTag() + '_' + w_myPair.first).c_str());
-                auto w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_timeSeries->getUuid() + w_vtkValidName).c_str(), w_parentNodeId);
+                auto w_nodeId = addNode("_" + w_timeSeries->getUuid() + w_vtkValidName, w_parentNodeId);
                 _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::TimeSeries)).c_str());
+                setNodeType(w_nodeId, TreeViewNodeType::TimeSeries);
             }
         }
         catch (const std::exception &e)
@@ -829,7 +908,6 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::selectNodeId(
         selectNodeIdParent(p_node);
 
         _currentSelection.insert(p_node);
-        _oldSelection.erase(p_node);
     }
     selectNodeIdChildren(p_node);
 
@@ -838,11 +916,11 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::selectNodeId(
 
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::selectNodeIdParent(uint32_t p_node)
 {
-    if (_output->GetDataAssembly()->GetParent(p_node) > 0)
+    const int w_nodeParent = getNodeInfo(p_node).parent;
+    if (w_nodeParent > 0)
     {
-        _currentSelection.insert(_output->GetDataAssembly()->GetParent(p_node));
-        _oldSelection.erase(_output->GetDataAssembly()->GetParent(p_node));
-        selectNodeIdParent(_output->GetDataAssembly()->GetParent(p_node));
+        _currentSelection.insert(w_nodeParent);
+        selectNodeIdParent(w_nodeParent);
     }
 }
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::selectNodeIdChildren(uint32_t p_node)
@@ -850,220 +928,238 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::selectNodeIdChildren
     for (uint32_t w_nodeChild : _output->GetDataAssembly()->GetChildNodes(p_node))
     {
         _currentSelection.insert(w_nodeChild);
-        _oldSelection.erase(w_nodeChild);
         selectNodeIdChildren(w_nodeChild);
     }
 }
 
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::clearSelection()
 {
-    _oldSelection = _currentSelection;
+    // the unselected nodes are found at the next request, by difference with _loadedSelection
     _currentSelection.clear();
 }
 
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::initMapperSet(const TreeViewNodeType p_type, const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
+const std::unordered_map<std::string, ResqmlDataRepositoryToVtkPartitionedDataSetCollection::MapperFactory> &ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getMapperFactories()
 {
-    CommonAbstractObjectToVtkPartitionedDataSet *w_caotvpds = nullptr;
-    const std::string w_uuid = std::string(_output->GetDataAssembly()->GetNodeName(p_nodeId)).substr(1);
-
-    COMMON_NS::AbstractObject* const w_abstractObject = _repository->getDataObjectByUuid(w_uuid);
+    typedef ResqmlDataRepositoryToVtkPartitionedDataSetCollection Repository;
 
-    if (p_type == TreeViewNodeType::WellboreCompletion)
-    {
-        try
+    const MapperFactory w_ijkGrid = {
+        MapperKind::IjkGrid,
+        [](Repository &p_repository, COMMON_NS::AbstractObject *p_object, uint32_t p_nbProcess, uint32_t p_processId) -> CommonAbstractObjectToVtkPartitionedDataSet *
+        {
+            return new ResqmlIjkGridToVtkExplicitStructuredGrid(static_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(p_object), p_processId, p_nbProcess, p_repository._ijkPartitioning, p_repository._ghostCellLayer);
+        },
+        nullptr};
+    const MapperFactory w_grid2d = {
+        MapperKind::Grid2d,
+        [](Repository &, COMMON_NS::AbstractObject *p_object, uint32_t, uint32_t) -> CommonAbstractObjectToVtkPartitionedDataSet *
+        {
+            return new ResqmlGrid2dToVtkStructuredGrid(static_cast<RESQML2_NS::Grid2dRepresentation *>(p_object));
+        },
+        nullptr};
+    const MapperFactory w_triangulatedSet = {
+        MapperKind::TriangulatedSet,
+        [](Repository &, COMMON_NS::AbstractObject *p_object, uint32_t, uint32_t) -> CommonAbstractObjectToVtkPartitionedDataSet *
+        {
+            return new ResqmlTriangulatedSetToVtkPartitionedDataSet(static_cast<RESQML2_NS::TriangulatedSetRepresentation *>(p_object));
+        },
+        nullptr};
+    const MapperFactory w_polylineSet = {
+        MapperKind::PolylineSet,
+        [](Repository &, COMMON_NS::AbstractObject *p_object, uint32_t, uint32_t) -> CommonAbstractObjectToVtkPartitionedDataSet *
+        {
+            return new ResqmlPolylineToVtkPolyData(static_cast<RESQML2_NS::PolylineSetRepresentation *>(p_object));
+        },
+        nullptr};
+    const MapperFactory w_unstructuredGrid = {
+        MapperKind::UnstructuredGrid,
+        [](Repository &p_repository, COMMON_NS::AbstractObject *p_object, uint32_t p_nbProcess, uint32_t p_processId) -> CommonAbstractObjectToVtkPartitionedDataSet *
         {
-            if (dynamic_cast<witsml2_1::WellboreCompletion*>(w_abstractObject) != nullptr)
+            return new ResqmlUnstructuredGridToVtkUnstructuredGrid(static_cast<RESQML2_NS::UnstructuredGridRepresentation *>(p_object), p_processId, p_nbProcess, p_repository._ghostCellLayer);
+        },
+        nullptr};
+    const MapperFactory w_ijkGridSubRepresentation = {
+        MapperKind::IjkGridSubRepresentation,
+        [](Repository &p_repository, COMMON_NS::AbstractObject *p_object, uint32_t, uint32_t) -> CommonAbstractObjectToVtkPartitionedDataSet *
+        {
+            RESQML2_NS::SubRepresentation *w_subRep = static_cast<RESQML2_NS::SubRepresentation *>(p_object);
+            auto *w_supportingGrid = static_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(w_subRep->getSupportingRepresentation(0));
+            const int w_supportingGridNodeId = p_repository.findNode("_" + w_supportingGrid->getUuid());
+            if (p_repository._nodeIdToMapper.find(w_supportingGridNodeId) == p_repository._nodeIdToMapper.end())
             {
-                _nodeIdToMapperSet[p_nodeId] = new WitsmlWellboreCompletionToVtkPartitionedDataSet(static_cast<witsml2_1::WellboreCompletion*>(w_abstractObject), p_processId, p_nbProcess);
+                p_repository._nodeIdToMapper[w_supportingGridNodeId] = new ResqmlIjkGridToVtkExplicitStructuredGrid(w_supportingGrid);
+                p_repository._nodeIdToMapper[w_supportingGridNodeId]->setGeometryPrecision(p_repository._geometryPrecision, p_repository._geometryOrigin);
             }
-            else
+            return new ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(w_subRep, static_cast<ResqmlIjkGridToVtkExplicitStructuredGrid *>(p_repository._nodeIdToMapper[w_supportingGridNodeId]), 0, 1, p_repository._subRepPointCompaction);
+        },
+        nullptr};
+    const MapperFactory w_unstructuredGridSubRepresentation = {
+        MapperKind::UnstructuredGridSubRepresentation,
+        [](Repository &p_repository, COMMON_NS::AbstractObject *p_object, uint32_t, uint32_t) -> CommonAbstractObjectToVtkPartitionedDataSet *
+        {
+            RESQML2_NS::SubRepresentation *w_subRep = static_cast<RESQML2_NS::SubRepresentation *>(p_object);
+            auto *w_supportingGrid = static_cast<RESQML2_NS::UnstructuredGridRepresentation *>(w_subRep->getSupportingRepresentation(0));
+            const int w_supportingGridNodeId = p_repository.findNode("_" + w_supportingGrid->getUuid());
+            if (p_repository._nodeIdToMapper.find(w_supportingGridNodeId) == p_repository._nodeIdToMapper.end())
             {
-                vtkOutputWindowDisplayErrorText(("Error object type in vtkDataAssembly for uuid: " + w_uuid + "\n").c_str());
+                p_repository._nodeIdToMapper[w_supportingGridNodeId] = new ResqmlUnstructuredGridToVtkUnstructuredGrid(w_supportingGrid);
+                p_repository._nodeIdToMapper[w_supportingGridNodeId]->setGeometryPrecision(p_repository._geometryPrecision, p_repository._geometryOrigin);
             }
-        }
-        catch (const std::exception& e)
+            return new ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(w_subRep, static_cast<ResqmlUnstructuredGridToVtkUnstructuredGrid *>(p_repository._nodeIdToMapper[w_supportingGridNodeId]), 0, 1, p_repository._subRepPointCompaction);
+        },
+        nullptr};
+    const MapperFactory w_wellboreTrajectory = {
+        MapperKind::WellboreTrajectory,
+        [](Repository &, COMMON_NS::AbstractObject *p_object, uint32_t, uint32_t) -> CommonAbstractObjectToVtkPartitionedDataSet *
         {
-            vtkOutputWindowDisplayErrorText(("Error when initialize uuid: " + w_uuid + "\n" + e.what()).c_str());
-        }
+            return new ResqmlWellboreTrajectoryToVtkPolyData(static_cast<RESQML2_NS::WellboreTrajectoryRepresentation *>(p_object));
+        },
+        nullptr};
+    const MapperFactory w_wellboreFrame = {
+        MapperKind::WellboreFrame,
+        nullptr,
+        [](Repository &, COMMON_NS::AbstractObject *p_object, uint32_t p_nbProcess, uint32_t p_processId) -> CommonAbstractObjectSetToVtkPartitionedDataSetSet *
+        {
+            return new ResqmlWellboreFrameToVtkPartitionedDataSet(static_cast<RESQML2_NS::WellboreFrameRepresentation *>(p_object), p_processId, p_nbProcess);
+        }};
+    const MapperFactory w_wellboreMarkerFrame = {
+        MapperKind::WellboreMarkerFrame,
+        nullptr,
+        [](Repository &, COMMON_NS::AbstractObject *p_object, uint32_t p_nbProcess, uint32_t p_processId) -> CommonAbstractObjectSetToVtkPartitionedDataSetSet *
+        {
+            return new ResqmlWellboreMarkerFrameToVtkPartitionedDataSet(static_cast<RESQML2_NS::WellboreMarkerFrameRepresentation *>(p_object), p_processId, p_nbProcess);
+        }};
+    const MapperFactory w_wellboreCompletion = {
+        MapperKind::WellboreCompletion,
+        nullptr,
+        [](Repository &, COMMON_NS::AbstractObject *p_object, uint32_t p_nbProcess, uint32_t p_processId) -> CommonAbstractObjectSetToVtkPartitionedDataSetSet *
+        {
+            return new WitsmlWellboreCompletionToVtkPartitionedDataSet(static_cast<witsml2_1::WellboreCompletion *>(p_object), p_processId, p_nbProcess);
+        }};
+
+    // the XML tag of a class is the same in all the versions of a standard
+    static const std::unordered_map<std::string, MapperFactory> w_factories = {
+        {std::string(RESQML2_NS::AbstractIjkGridRepresentation::XML_TAG), w_ijkGrid},
+        {std::string(RESQML2_NS::AbstractIjkGridRepresentation::XML_TAG_TRUNCATED), w_ijkGrid},
+        {std::string(RESQML2_NS::Grid2dRepresentation::XML_TAG), w_grid2d},
+        {std::string(RESQML2_NS::TriangulatedSetRepresentation::XML_TAG), w_triangulatedSet},
+        {std::string(RESQML2_NS::PolylineSetRepresentation::XML_TAG), w_polylineSet},
+        {std::string(RESQML2_NS::UnstructuredGridRepresentation::XML_TAG), w_unstructuredGrid},
+        {std::string(RESQML2_NS::SubRepresentation::XML_TAG) + "/" + RESQML2_NS::AbstractIjkGridRepresentation::XML_TAG, w_ijkGridSubRepresentation},
+        {std::string(RESQML2_NS::SubRepresentation::XML_TAG) + "/" + RESQML2_NS::AbstractIjkGridRepresentation::XML_TAG_TRUNCATED, w_ijkGridSubRepresentation},
+        {std::string(RESQML2_NS::SubRepresentation::XML_TAG) + "/" + RESQML2_NS::UnstructuredGridRepresentation::XML_TAG, w_unstructuredGridSubRepresentation},
+        {std::string(RESQML2_NS::WellboreTrajectoryRepresentation::XML_TAG), w_wellboreTrajectory},
+        {std::string(RESQML2_NS::WellboreFrameRepresentation::XML_TAG), w_wellboreFrame},
+        {std::string(RESQML2_NS::WellboreMarkerFrameRepresentation::XML_TAG), w_wellboreMarkerFrame},
+        {std::string(witsml2_1::WellboreCompletion::XML_TAG), w_wellboreCompletion}};
+    return w_factories;
+}
+
+const ResqmlDataRepositoryToVtkPartitionedDataSetCollection::MapperFactory *ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getMapperFactory(uint32_t p_nodeId)
+{
+    if (p_nodeId >= _nodeInfos.size())
+    {
+        return nullptr;
     }
-    else if (p_type == TreeViewNodeType::WellboreMarkerFrame)
+    NodeInfo &w_nodeInfo = _nodeInfos[p_nodeId];
+    if (w_nodeInfo.mapperFactory == nullptr)
     {
-        try
+        COMMON_NS::AbstractObject *const w_abstractObject = _repository->getDataObjectByUuid(w_nodeInfo.uuid);
+        if (w_abstractObject == nullptr)
         {
-            if (dynamic_cast<RESQML2_NS::WellboreMarkerFrameRepresentation *>(w_abstractObject) != nullptr)
-            {
-                _nodeIdToMapperSet[p_nodeId] = new ResqmlWellboreMarkerFrameToVtkPartitionedDataSet(static_cast<RESQML2_NS::WellboreMarkerFrameRepresentation*>(w_abstractObject), p_processId, p_nbProcess);
-            }
-            else
-            {
-                vtkOutputWindowDisplayErrorText(("Error object type in vtkDataAssembly for uuid: " + w_uuid + "\n").c_str());
-            }
+            return nullptr;
         }
-        catch (const std::exception& e)
+        std::string w_key = w_abstractObject->getXmlTag();
+        if (w_key == RESQML2_NS::SubRepresentation::XML_TAG)
         {
-            vtkOutputWindowDisplayErrorText(("Error when initialize uuid: " + w_uuid + "\n" + e.what()).c_str());
+            // the mapper of a subrepresentation depends on its supporting representation
+            w_key += "/" + static_cast<RESQML2_NS::SubRepresentation *>(w_abstractObject)->getSupportingRepresentation(0)->getXmlTag();
         }
-    }
-    else if (p_type == TreeViewNodeType::WellboreFrame)
-    {
-        try
+        auto w_it = getMapperFactories().find(w_key);
+        if (w_it == getMapperFactories().end())
         {
-            if (dynamic_cast<RESQML2_NS::WellboreFrameRepresentation *>(w_abstractObject) != nullptr)
+            // a class derived from a mapped one uses the mapper of this one
+            w_key = GetMappedBaseXmlTag(w_abstractObject);
+            if (w_key == RESQML2_NS::SubRepresentation::XML_TAG)
             {
-                _nodeIdToMapperSet[p_nodeId] = new ResqmlWellboreFrameToVtkPartitionedDataSet(static_cast<RESQML2_NS::WellboreFrameRepresentation*>(w_abstractObject), p_processId, p_nbProcess);
-            }
-            else
-            {
-                vtkOutputWindowDisplayErrorText(("Error object type in vtkDataAssembly for uuid: " + w_uuid + "\n").c_str());
+                w_key += "/" + GetMappedBaseXmlTag(static_cast<RESQML2_NS::SubRepresentation *>(w_abstractObject)->getSupportingRepresentation(0));
             }
+            w_it = getMapperFactories().find(w_key);
         }
-        catch (const std::exception& e)
+        if (w_it != getMapperFactories().end())
         {
-            vtkOutputWindowDisplayErrorText(("Error when initialize uuid: " + w_uuid + "\n" + e.what()).c_str());
+            w_nodeInfo.mapperFactory = &w_it->second;
+        }
+        else if (w_abstractObject->getXmlTag() == RESQML2_NS::SubRepresentation::XML_TAG)
+        {
+            vtkOutputWindowDisplayWarningText(("FESPP only supports IJK Grid or UnstructuredGrid as supporting representation of subrepresentation  (for uuid: " + w_nodeInfo.uuid + ")\n").c_str());
         }
     }
-
-}
-
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadMapper(const TreeViewNodeType p_type, const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
-{
-    if (TreeViewNodeType::Representation == p_type)
-    {
-        loadRepresentationMapper(p_nodeId, p_nbProcess, p_processId);
-    } 
-    else if (TreeViewNodeType::WellboreTrajectory == p_type)
-    {
-        loadWellboreTrajectoryMapper(p_nodeId);
-    }
-    else if (TreeViewNodeType::SubRepresentation == p_type)
-    {
-        loadWellboreTrajectoryMapper(p_nodeId);
-    }
+    return w_nodeInfo.mapperFactory;
 }
 
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadRepresentationMapper(const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::initMapperSet(const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
 {
-    CommonAbstractObjectToVtkPartitionedDataSet* w_caotvpds = nullptr;
-    const std::string w_uuid = std::string(_output->GetDataAssembly()->GetNodeName(p_nodeId)).substr(1);
-    COMMON_NS::AbstractObject* const w_abstractObject = _repository->getDataObjectByUuid(w_uuid);
+    const std::string w_uuid = getNodeInfo(p_nodeId).uuid;
 
-    if (dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_abstractObject) != nullptr)
-    {
-        w_caotvpds = new ResqmlIjkGridToVtkExplicitStructuredGrid(static_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_abstractObject), p_processId, p_nbProcess);
-    }
-    else if (dynamic_cast<RESQML2_NS::Grid2dRepresentation*>(w_abstractObject) != nullptr)
-    {
-        w_caotvpds = new ResqmlGrid2dToVtkStructuredGrid(static_cast<RESQML2_NS::Grid2dRepresentation*>(w_abstractObject));
-    }
-    else if (dynamic_cast<RESQML2_NS::TriangulatedSetRepresentation*>(w_abstractObject) != nullptr)
-    {
-        w_caotvpds = new ResqmlTriangulatedSetToVtkPartitionedDataSet(static_cast<RESQML2_NS::TriangulatedSetRepresentation*>(w_abstractObject));
-    }
-    else if (dynamic_cast<RESQML2_NS::PolylineSetRepresentation*>(w_abstractObject) != nullptr)
-    {
-        w_caotvpds = new ResqmlPolylineToVtkPolyData(static_cast<RESQML2_NS::PolylineSetRepresentation*>(w_abstractObject));
-    }
-    else if (dynamic_cast<RESQML2_NS::UnstructuredGridRepresentation*>(w_abstractObject) != nullptr)
-    {
-        w_caotvpds = new ResqmlUnstructuredGridToVtkUnstructuredGrid(static_cast<RESQML2_NS::UnstructuredGridRepresentation*>(w_abstractObject));
-    }
-    else if (dynamic_cast<RESQML2_NS::SubRepresentation*>(w_abstractObject) != nullptr)
+    try
     {
-        RESQML2_NS::SubRepresentation* w_subRep = static_cast<RESQML2_NS::SubRepresentation*>(w_abstractObject);
-
-        if (dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_subRep->getSupportingRepresentation(0)) != nullptr)
+        const MapperFactory *const w_factory = getMapperFactory(p_nodeId);
+        if (w_factory != nullptr && w_factory->newMapperSet != nullptr)
         {
-            auto* w_supportingGrid = static_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_subRep->getSupportingRepresentation(0));
-            if (_nodeIdToMapper.find(_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())) == _nodeIdToMapper.end())
-            {
-                _nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())] = new ResqmlIjkGridToVtkExplicitStructuredGrid(w_supportingGrid);
-            }
-            w_caotvpds = new ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(w_subRep, dynamic_cast<ResqmlIjkGridToVtkExplicitStructuredGrid*>(_nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())]));
+            _nodeIdToMapperSet[p_nodeId] = w_factory->newMapperSet(*this, _repository->getDataObjectByUuid(w_uuid), p_nbProcess, p_processId);
+            _nodeIdToMapperSet[p_nodeId]->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
         }
-        else if (dynamic_cast<RESQML2_NS::UnstructuredGridRepresentation*>(w_subRep->getSupportingRepresentation(0)) != nullptr)
+        else
         {
-            auto* w_supportingGrid = static_cast<RESQML2_NS::UnstructuredGridRepresentation*>(w_subRep->getSupportingRepresentation(0));
-            if (_nodeIdToMapper.find(_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())) == _nodeIdToMapper.end())
-            {
-                _nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())] = new ResqmlUnstructuredGridToVtkUnstructuredGrid(w_supportingGrid);
-            }
-            w_caotvpds = new ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(w_subRep, dynamic_cast<ResqmlUnstructuredGridToVtkUnstructuredGrid*>(_nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())]));
-        }
-        else {
-            vtkOutputWindowDisplayWarningText(("FESPP only supports IJK Grid or UnstructuredGrid as supporting representation of subrepresentation  (for uuid: " + w_uuid +  ")\n").c_str());
+            vtkOutputWindowDisplayErrorText(("Error object type in vtkDataAssembly for uuid: " + w_uuid + "\n").c_str());
         }
     }
-    _nodeIdToMapper[p_nodeId] = w_caotvpds;
-    try
-    { // load representation
-        _nodeIdToMapper[p_nodeId]->loadVtkObject();
-        return;
-    }
     catch (const std::exception& e)
     {
-        vtkOutputWindowDisplayErrorText(("Error when rendering uuid: " + w_uuid + "\n" + e.what()).c_str());
-        return;
+        vtkOutputWindowDisplayErrorText(("Error when initialize uuid: " + w_uuid + "\n" + e.what()).c_str());
     }
 }
 
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadWellboreTrajectoryMapper(const uint32_t p_nodeId)
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadMapper(const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
 {
-    const std::string w_uuid = std::string(_output->GetDataAssembly()->GetNodeName(p_nodeId)).substr(1);
-    COMMON_NS::AbstractObject* const w_abstractObject = _repository->getDataObjectByUuid(w_uuid);
+    const std::string w_uuid = getNodeInfo(p_nodeId).uuid;
 
-
-    if (dynamic_cast<RESQML2_NS::WellboreTrajectoryRepresentation*>(w_abstractObject) != nullptr)
-    {
-        _nodeIdToMapper[p_nodeId] = new ResqmlWellboreTrajectoryToVtkPolyData(static_cast<RESQML2_NS::WellboreTrajectoryRepresentation*>(w_abstractObject));
-    } else {
-        vtkOutputWindowDisplayErrorText(("Error object type in vtkDataAssembly for uuid: " + w_uuid + "\n").c_str());
-        return;
-    }
     try
-    { // load representation
+    {
+        const MapperFactory *const w_factory = getMapperFactory(p_nodeId);
+        if (w_factory == nullptr || w_factory->newMapper == nullptr)
+        {
+            vtkOutputWindowDisplayErrorText(("Error object type in vtkDataAssembly for uuid: " + w_uuid + "\n").c_str());
+            return;
+        }
+        _nodeIdToMapper[p_nodeId] = w_factory->newMapper(*this, _repository->getDataObjectByUuid(w_uuid), p_nbProcess, p_processId);
+        // load representation
+        _nodeIdToMapper[p_nodeId]->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
         _nodeIdToMapper[p_nodeId]->loadVtkObject();
-        return;
     }
     catch (const std::exception& e)
     {
         vtkOutputWindowDisplayErrorText(("Error when rendering uuid: " + w_uuid + "\n" + e.what()).c_str());
-        return;
     }
 }
 
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(const TreeViewNodeType p_type, const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId, const double p_time)
 {
-    const std::string w_uuid = std::string(_output->GetDataAssembly()->GetNodeName(p_nodeId)).substr(1);
+    const std::string w_uuid = getNodeInfo(p_nodeId).uuid;
 
     // search representation NodeId
-    uint32_t w_nodeParent = _output->GetDataAssembly()->GetParent(p_nodeId);
-    uint32_t value_type;
-    _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", value_type);
-    TreeViewNodeType w_typeParent = static_cast<TreeViewNodeType>(value_type);
-    while (w_typeParent == TreeViewNodeType::Collection)
-    {
-        w_nodeParent = _output->GetDataAssembly()->GetParent(w_nodeParent);
-        value_type;
-        _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", value_type);
-        w_typeParent = static_cast<TreeViewNodeType>(value_type);
-    }
+    const uint32_t w_nodeParent = getNodeInfo(p_nodeId).dataParent;
 
     if (TreeViewNodeType::Perforation == p_type)
     {
         try
         {
-            if (static_cast<WitsmlWellboreCompletionToVtkPartitionedDataSet*>(_nodeIdToMapperSet[w_nodeParent]))
+            const std::shared_ptr<const NodeInfo::Perforation> w_perforation = getNodeInfo(p_nodeId).perforation;
+            if (static_cast<WitsmlWellboreCompletionToVtkPartitionedDataSet*>(_nodeIdToMapperSet[w_nodeParent]) && w_perforation != nullptr)
             {
-                const char* w_connection;
-                _output->GetDataAssembly()->GetAttribute(p_nodeId, "connection", w_connection);
-                const char* w_name;
-                _output->GetDataAssembly()->GetAttribute(p_nodeId, "label", w_name);
-                const char* w_skin_s;
-                _output->GetDataAssembly()->GetAttribute(p_nodeId, "skin", w_skin_s);
-                const double w_skin = std::strtod(w_skin_s, nullptr);
-                if (!_nodeIdToMapperSet[w_nodeParent]->existUuid(w_connection))
+                if (!_nodeIdToMapperSet[w_nodeParent]->existUuid(w_perforation->connection))
                 {
-                    (static_cast<WitsmlWellboreCompletionToVtkPartitionedDataSet*>(_nodeIdToMapperSet[w_nodeParent]))->addPerforation(w_connection, w_name, w_skin);
+                    (static_cast<WitsmlWellboreCompletionToVtkPartitionedDataSet*>(_nodeIdToMapperSet[w_nodeParent]))->addPerforation(w_perforation->connection, w_perforation->label, w_perforation->skin);
                 }
                 else
                 {
@@ -1109,7 +1205,7 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
         {
             if (static_cast<ResqmlWellboreMarkerFrameToVtkPartitionedDataSet*>(_nodeIdToMapperSet[w_nodeParent]))
             {
-                const std::string w_uuidParent = std::string(_output->GetDataAssembly()->GetNodeName(w_nodeParent)).substr(1);
+                const std::string w_uuidParent = getNodeInfo(w_nodeParent).uuid;
                 resqml2::WellboreMarkerFrameRepresentation* w_markerFrame = _repository->getDataObjectByUuid<resqml2::WellboreMarkerFrameRepresentation>(w_uuidParent);
                 if (!_nodeIdToMapperSet[w_nodeParent]->existUuid(w_uuid))
                 {
@@ -1142,7 +1238,9 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
                 if (abstractRepresentation->getOutput()->GetNumberOfPartitions() == 0) {
                     abstractRepresentation->loadVtkObject();
                 }
+                applyPropertyReadOptions(abstractRepresentation);
                 abstractRepresentation->addDataArray(w_uuid);
+                cachePropertyRanges(abstractRepresentation, w_uuid);
             }
             else
             {
@@ -1168,7 +1266,38 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
                 if (abstractRepresentation->getOutput()->GetNumberOfPartitions() == 0) {
                     abstractRepresentation->loadVtkObject();
                 }
-                abstractRepresentation->addDataArray(_timeSeriesUuidAndTitleToIndexAndPropertiesUuid[w_tsUuid][w_nodeName][p_time]);
+                applyPropertyReadOptions(abstractRepresentation);
+                std::map<double, std::string> &w_steps = _timeSeriesUuidAndTitleToIndexAndPropertiesUuid[w_tsUuid][w_nodeName];
+                const std::string &w_propertyUuid = w_steps[p_time];
+                // only the current step stays in the representation, the other ones being in the prefetch cache
+                for (const auto &w_step : w_steps)
+                {
+                    if (w_step.second != w_propertyUuid && abstractRepresentation->getDataArray(w_step.second) != nullptr)
+                    {
+                        abstractRepresentation->deleteDataArray(w_step.second);
+                    }
+                }
+                if (abstractRepresentation->getDataArray(w_propertyUuid) == nullptr)
+                {
+                    const ResqmlTimeSeriesPrefetcher::Key w_key(abstractRepresentation->getUuid(), w_uuid, p_time);
+                    const vtkSmartPointer<vtkDataArray> w_values = _timeSeriesPrefetcher.get(w_key);
+                    abstractRepresentation->addDataArray(w_propertyUuid, 0, w_values);
+                    cachePropertyRanges(abstractRepresentation, w_propertyUuid);
+                    if (w_values == nullptr)
+                    {
+                        _timeSeriesPrefetcher.insert(w_key, abstractRepresentation->getDataArray(w_propertyUuid)->getVtkData());
+                    }
+                }
+
+                // read the next steps while this one is rendered
+                std::vector<std::pair<ResqmlTimeSeriesPrefetcher::Key, ResqmlTimeSeriesPrefetcher::Loader>> w_nextSteps;
+                auto w_stepIt = w_steps.upper_bound(p_time);
+                for (uint32_t w_i = 0; w_i < _timeStepPrefetchWindow && w_stepIt != w_steps.end(); ++w_i, ++w_stepIt)
+                {
+                    w_nextSteps.push_back(std::make_pair(ResqmlTimeSeriesPrefetcher::Key(abstractRepresentation->getUuid(), w_uuid, w_stepIt->first),
+                                                         abstractRepresentation->getDataArrayLoader(w_stepIt->second)));
+                }
+                _timeSeriesPrefetcher.prefetch(w_nextSteps);
             }
         }
         catch (const std::exception& e)
@@ -1180,57 +1309,51 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
 }
 
 /**
- * delete oldSelection mapper
+ * delete the mappers and the data of the unselected nodes
  */
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double p_time)
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(const std::set<uint32_t> &p_nodeIds)
 {
-    // initialization the output (VtkPartitionedDatasSetCollection) with same vtkDataAssembly
-    vtkSmartPointer<vtkDataAssembly> w_Assembly = vtkSmartPointer<vtkDataAssembly>::New();
-    w_Assembly->DeepCopy(_output->GetDataAssembly());
-    _output = vtkSmartPointer<vtkPartitionedDataSetCollection>::New();
-    _output->SetDataAssembly(w_Assembly);
+    // the subrepresentations are unregistered from their supporting grid before this grid may be deleted
+    std::vector<uint32_t> w_nodeIds(p_nodeIds.begin(), p_nodeIds.end());
+    std::stable_partition(w_nodeIds.begin(), w_nodeIds.end(), [this](uint32_t p_nodeId)
+                          { return getNodeInfo(p_nodeId).type == TreeViewNodeType::SubRepresentation; });
 
     // delete unchecked object
-    for (const uint32_t w_nodeId : _oldSelection)
+    for (const uint32_t w_nodeId : w_nodeIds)
     {
-        // retrieval of object type for nodeid
-        uint32_t w_valueType;
-        w_Assembly->GetAttribute(w_nodeId, "type", w_valueType);
-        TreeViewNodeType valueType = static_cast<TreeViewNodeType>(w_valueType);
-
-        // retrieval of object UUID for nodeId
-        const std::string uuid_unselect = std::string(w_Assembly->GetNodeName(w_nodeId)).substr(1);
+        // retrieval of object type and UUID for nodeid
+        const NodeInfo &w_nodeInfo = getNodeInfo(w_nodeId);
+        const TreeViewNodeType valueType = w_nodeInfo.type;
+        const std::string &uuid_unselect = w_nodeInfo.uuid;
 
         if (valueType == TreeViewNodeType::TimeSeries)
         { // TimeSerie properties deselection
             std::string w_timeSeriesuuid = uuid_unselect.substr(0, 36);
             std::string w_nodeName = uuid_unselect.substr(36);
 
-            const uint32_t w_nodeParent = w_Assembly->GetParent(w_Assembly->FindFirstNodeWithName(("_" + uuid_unselect).c_str()));
+            const uint32_t w_nodeParent = w_nodeInfo.dataParent;
             if (_nodeIdToMapper.find(w_nodeParent) != _nodeIdToMapper.end())
             {
-                static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent])->deleteDataArray(_timeSeriesUuidAndTitleToIndexAndPropertiesUuid[w_timeSeriesuuid][w_nodeName][p_time]);
+                // the representation may hold another step than the requested one
+                ResqmlAbstractRepresentationToVtkPartitionedDataSet *w_representation = static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent]);
+                for (const auto &w_step : _timeSeriesUuidAndTitleToIndexAndPropertiesUuid[w_timeSeriesuuid][w_nodeName])
+                {
+                    if (w_representation->getDataArray(w_step.second) != nullptr)
+                    {
+                        w_representation->deleteDataArray(w_step.second);
+                    }
+                }
             }
         }
         else if (valueType == TreeViewNodeType::Properties)
         {
-            uint32_t w_nodeParent = _output->GetDataAssembly()->GetParent(w_nodeId);
-            uint32_t w_typeValue;
-            _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", w_typeValue);
-            TreeViewNodeType w_typeParent = static_cast<TreeViewNodeType>(w_typeValue);
-            while (w_typeParent == TreeViewNodeType::Collection)
-            {
-                w_nodeParent = _output->GetDataAssembly()->GetParent(w_nodeParent);
-                w_typeValue;
-                _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", w_typeValue);
-                w_typeParent = static_cast<TreeViewNodeType>(w_typeValue);
-            }
+            const uint32_t w_nodeParent = w_nodeInfo.dataParent;
 
             try
             {
                 if (_nodeIdToMapper.find(w_nodeParent) != _nodeIdToMapper.end())
                 {
-                    static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent])->deleteDataArray(std::string(w_Assembly->GetNodeName(w_nodeId)).substr(1));
+                    static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent])->deleteDataArray(uuid_unselect);
                 }
             }
             catch (const std::exception &e)
@@ -1241,12 +1364,12 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double
         else if (valueType == TreeViewNodeType::WellboreMarker ||
             valueType == TreeViewNodeType::WellboreChannel)
         {
-            const uint32_t w_nodeParent = w_Assembly->GetParent(w_nodeId);
+            const uint32_t w_nodeParent = w_nodeInfo.parent;
             try
             {
                 if (_nodeIdToMapperSet.find(w_nodeParent) != _nodeIdToMapperSet.end())
                 {
-                    _nodeIdToMapperSet[w_nodeParent]->removeCommonAbstractObjectToVtkPartitionedDataSet(std::string(w_Assembly->GetNodeName(w_nodeId)).substr(1));
+                    _nodeIdToMapperSet[w_nodeParent]->removeCommonAbstractObjectToVtkPartitionedDataSet(uuid_unselect);
                 }
             }
             catch (const std::exception &e)
@@ -1260,14 +1383,15 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double
             {
                 if (_nodeIdToMapper.find(w_nodeId) != _nodeIdToMapper.end())
                 {
-                    std::string uuid_supporting_grid = "";
-                    if (dynamic_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(_nodeIdToMapper[w_nodeId]) != nullptr)
+                    // the kind of the mapper was recorded in the node table when it was created
+                    const MapperFactory *const w_factory = w_nodeInfo.mapperFactory;
+                    if (w_factory != nullptr && w_factory->kind == MapperKind::UnstructuredGridSubRepresentation)
                     {
-                        uuid_supporting_grid = static_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(_nodeIdToMapper[w_nodeId])->unregisterToMapperSupportingGrid();
+                        static_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(_nodeIdToMapper[w_nodeId])->unregisterToMapperSupportingGrid();
                     }
-                    else if (dynamic_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(_nodeIdToMapper[w_nodeId]) != nullptr)
+                    else if (w_factory != nullptr && w_factory->kind == MapperKind::IjkGridSubRepresentation)
                     {
-                        uuid_supporting_grid = static_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(_nodeIdToMapper[w_nodeId])->unregisterToMapperSupportingGrid();
+                        static_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(_nodeIdToMapper[w_nodeId])->unregisterToMapperSupportingGrid();
                     }
                     delete _nodeIdToMapper[w_nodeId];
                     _nodeIdToMapper.erase(w_nodeId);
@@ -1301,14 +1425,12 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double
         else if (valueType == TreeViewNodeType::Perforation)
         // delete child of CommonAbstractObjectSetToVtkPartitionedDataSetSet
         {
-            const uint32_t w_nodeParent = w_Assembly->GetParent(w_nodeId);
+            const uint32_t w_nodeParent = w_nodeInfo.parent;
             try
             {
-                if (_nodeIdToMapperSet.find(w_nodeParent) != _nodeIdToMapperSet.end())
+                if (_nodeIdToMapperSet.find(w_nodeParent) != _nodeIdToMapperSet.end() && w_nodeInfo.perforation != nullptr)
                 {
-                    const char *w_connection;
-                    _output->GetDataAssembly()->GetAttribute(w_nodeId, "connection", w_connection);
-                    _nodeIdToMapperSet[w_nodeParent]->removeCommonAbstractObjectToVtkPartitionedDataSet(w_connection);
+                    _nodeIdToMapperSet[w_nodeParent]->removeCommonAbstractObjectToVtkPartitionedDataSet(w_nodeInfo.perforation->connection);
                 }
             }
             catch (const std::exception &e)
@@ -1338,100 +1460,533 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double
 
 vtkPartitionedDataSetCollection *ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getVtkPartitionedDatasSetCollection(const double p_time, const uint32_t p_nbProcess, const uint32_t p_processId)
 {
-    deleteMapper(p_time);
+    // the request reads alone, then the steps following p_time are prefetched
+    ResqmlTimeSeriesPrefetcher::ScopedPause w_pause(_timeSeriesPrefetcher);
+    // the prefetch of the other repositories may be reading : fesapi is not called concurrently
+    std::lock_guard<std::recursive_mutex> w_readLock(ResqmlPropertyToVtkDataArray::getReadMutex());
+    if (_threadCount > 0)
+    {
+        // the thread count only applies to the SMP loops of the request, the other VTK filters keeping the process wide one
+        vtkSMPTools::LocalScope(vtkSMPTools::Config(static_cast<int>(_threadCount)), [this, p_time, p_nbProcess, p_processId]()
+                                { loadSelection(p_time, p_nbProcess, p_processId); });
+    }
+    else
+    {
+        loadSelection(p_time, p_nbProcess, p_processId);
+    }
+
+    updateOutput();
+    return _output;
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadSelection(const double p_time, const uint32_t p_nbProcess, const uint32_t p_processId)
+{
+    const bool w_timeChanged = !(p_time == _loadedTime); // _loadedTime is NaN before the first output
+    if (w_timeChanged)
+    {
+        _timeSeriesPrefetcher.cancel();
+    }
+
+    initGeometryOrigin();
 
-    // vtkParitionedDataSetCollection - hierarchy - build
-    // foreach selection node init object
-    auto w_it = _currentSelection.begin();
-    while (w_it != _currentSelection.end())
+    // selection changes since the last output
+    std::set<uint32_t> w_removedNodes;
+    std::set_difference(_loadedSelection.begin(), _loadedSelection.end(), _currentSelection.begin(), _currentSelection.end(), std::inserter(w_removedNodes, w_removedNodes.end()));
+    deleteMapper(w_removedNodes);
+    std::set<uint32_t> w_changedNodes = w_removedNodes;
+
+    // foreach added selection node init object, the time series being also updated at each time change
+    for (const uint32_t w_nodeId : _currentSelection)
     {
-        uint32_t w_typeValue;
-        _output->GetDataAssembly()->GetAttribute(*w_it, "type", w_typeValue);
-        TreeViewNodeType w_type = static_cast<TreeViewNodeType>(w_typeValue);
+        const TreeViewNodeType w_type = getNodeInfo(w_nodeId).type;
+        if (_loadedSelection.find(w_nodeId) != _loadedSelection.end() &&
+            !(w_timeChanged && w_type == TreeViewNodeType::TimeSeries))
+        {
+            continue;
+        }
+        w_changedNodes.insert(w_nodeId);
 
         // init MapperSet && save nodeId for attach to vtkPartitionedDataSetcollection
         if (getMapperType(w_type) == MapperType::MapperSet)
         {
             // initialize mapperSet with nodeId
-            if (_nodeIdToMapperSet.find(*w_it) == _nodeIdToMapperSet.end())
+            if (_nodeIdToMapperSet.find(w_nodeId) == _nodeIdToMapperSet.end())
             {
-                initMapperSet(w_type, *w_it, p_nbProcess, p_processId);
+                initMapperSet(w_nodeId, p_nbProcess, p_processId);
             }
-            ++w_it;
         }
         else if (getMapperType(w_type) == MapperType::Mapper)
         {
             // load mapper with nodeId
-            if (_nodeIdToMapper.find(*w_it) == _nodeIdToMapper.end())
+            if (_nodeIdToMapper.find(w_nodeId) == _nodeIdToMapper.end())
             {
-                loadMapper(w_type, *w_it, p_nbProcess, p_processId);
+                loadMapper(w_nodeId, p_nbProcess, p_processId);
             }
-            ++w_it;
-        }
-        else if (getMapperType(w_type) == MapperType::Folder)
-        {
-            ++w_it;
         }
         else if (getMapperType(w_type) == MapperType::Data)
         {
-            addDataToParent(w_type, *w_it, p_nbProcess, p_processId, p_time);
-            ++w_it;
+            addDataToParent(w_type, w_nodeId, p_nbProcess, p_processId, p_time);
         }
     }
+    _loadedSelection = _currentSelection;
+    _loadedTime = p_time;
 
-    uint32_t w_PartitionIndex = 0;
-    // foreach selection node load object
-    for (const uint32_t w_nodeSelection : _currentSelection)
+    // load the mapper sets which are new or whose children changed
+    std::set<uint32_t> w_changedMapperSets;
+    for (const uint32_t w_nodeId : w_changedNodes)
     {
-        uint32_t w_typeValue;
-        _output->GetDataAssembly()->GetAttribute(w_nodeSelection, "type", w_typeValue);
-        TreeViewNodeType w_type = static_cast<TreeViewNodeType>(w_typeValue);
+        if (_nodeIdToMapperSet.find(w_nodeId) != _nodeIdToMapperSet.end())
+        {
+            w_changedMapperSets.insert(w_nodeId);
+        }
+        const int w_nodeParent = getNodeInfo(w_nodeId).parent;
+        if (_nodeIdToMapperSet.find(w_nodeParent) != _nodeIdToMapperSet.end())
+        {
+            w_changedMapperSets.insert(w_nodeParent);
+        }
+    }
+    for (const uint32_t w_nodeId : w_changedMapperSets)
+    {
+        try
+        {
+            _nodeIdToMapperSet[w_nodeId]->loadVtkObject();
+        }
+        catch (const std::exception& e)
+        {
+            vtkOutputWindowDisplayErrorText(("Fesapi Error for uuid : " + getNodeInfo(w_nodeId).uuid + "\n" + e.what()).c_str());
+        }
+    }
+}
 
-        if (getMapperType(w_type) == MapperType::MapperSet)
+namespace
+{
+    /**
+     * Read some points of a representation in the VTK global frame, the same ones whatever the pieces loaded by the processes :
+     * the first K interface of an IJK grid if it can be read alone, else the first patch.
+     */
+    std::vector<double> readFirstPoints(RESQML2_NS::AbstractRepresentation *p_representation)
+    {
+        auto const *w_crs = p_representation->getLocalCrs(0);
+        const bool w_partialCrs = w_crs == nullptr || w_crs->isPartial();
+        std::vector<double> w_xyzPoints;
+        bool w_isRead = false;
+        RESQML2_NS::AbstractIjkGridRepresentation *w_ijkGrid = dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(p_representation);
+        if (w_ijkGrid != nullptr)
         {
-            // load mapper representation
-            if (_nodeIdToMapperSet.find(w_nodeSelection) != _nodeIdToMapperSet.end())
+            try
             {
-                try
+                w_xyzPoints.resize(w_ijkGrid->getXyzPointCountOfKInterface() * 3);
+                w_ijkGrid->getXyzPointsOfKInterface(0, w_xyzPoints.data());
+                if (!w_partialCrs)
                 {
-                    _nodeIdToMapperSet[w_nodeSelection]->loadVtkObject();
+                    w_crs->convertXyzPointsToGlobalCrs(w_xyzPoints.data(), w_xyzPoints.size() / 3);
                 }
-                catch (const std::exception& e)
-                    {
-                        vtkOutputWindowDisplayErrorText(("Fesapi Error for uuid : " + std::string(_output->GetDataAssembly()->GetNodeName(w_nodeSelection)).substr(1) + "\n" + e.what()).c_str());
-                    }
-                for (auto partition : _nodeIdToMapperSet[w_nodeSelection]->getMapperSet())
+                w_isRead = true;
+            }
+            catch (const std::exception &)
+            {
+                // the geometry of this grid is not stored K interface by K interface
+            }
+        }
+        if (!w_isRead)
+        {
+            w_xyzPoints.resize(p_representation->getXyzPointCountOfPatch(0) * 3);
+            if (w_partialCrs)
+            {
+                p_representation->getXyzPointsOfPatch(0, w_xyzPoints.data());
+            }
+            else
+            {
+                p_representation->getXyzPointsOfPatchInGlobalCrs(0, w_xyzPoints.data());
+            }
+        }
+        if (!w_partialCrs && w_crs->isDepthOriented())
+        {
+            for (size_t w_zCoordIndex = 2; w_zCoordIndex < w_xyzPoints.size(); w_zCoordIndex += 3)
+            {
+                w_xyzPoints[w_zCoordIndex] *= -1;
+            }
+        }
+        return w_xyzPoints;
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::initGeometryOrigin()
+{
+    if (_geometryPrecision != GeometryPrecision::Float || !std::isnan((*_geometryOrigin)[0]))
+    {
+        return;
+    }
+
+    // the origin is the first defined point of the first selected representation, the selection being the same on all the processes
+    for (const uint32_t w_nodeId : _currentSelection)
+    {
+        RESQML2_NS::AbstractRepresentation *w_representation = dynamic_cast<RESQML2_NS::AbstractRepresentation *>(_repository->getDataObjectByUuid(getNodeInfo(w_nodeId).uuid));
+        if (w_representation != nullptr && w_representation->getXmlTag() == RESQML2_NS::SubRepresentation::XML_TAG)
+        {
+            w_representation = static_cast<RESQML2_NS::SubRepresentation *>(w_representation)->getSupportingRepresentation(0);
+        }
+        if (w_representation == nullptr || w_representation->isPartial())
+        {
+            continue;
+        }
+        try
+        {
+            const std::vector<double> w_xyzPoints = readFirstPoints(w_representation);
+            for (size_t w_coordIndex = 0; w_coordIndex < w_xyzPoints.size(); w_coordIndex += 3)
+            {
+                if (!std::isnan(w_xyzPoints[w_coordIndex]) && !std::isnan(w_xyzPoints[w_coordIndex + 1]) && !std::isnan(w_xyzPoints[w_coordIndex + 2]))
                 {
-                    _output->SetPartitionedDataSet(w_PartitionIndex, partition->getOutput());
-                    _output->GetMetaData(w_PartitionIndex)->Set(vtkCompositeDataSet::NAME(), partition->getTitle() + '(' + partition->getUuid() + ')');
-                    GetAssembly()->AddDataSetIndex(w_nodeSelection, w_PartitionIndex + 1); // attach hierarchy to assembly
-                    w_PartitionIndex++;
+                    *_geometryOrigin = {{w_xyzPoints[w_coordIndex], w_xyzPoints[w_coordIndex + 1], w_xyzPoints[w_coordIndex + 2]}};
+                    return;
                 }
             }
         }
-        else if (getMapperType(w_type) == MapperType::Mapper)
+        catch (const std::exception &)
+        {
+            // this representation has no readable point : try the next one
+        }
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopyOutput(vtkPartitionedDataSetCollection *p_collection, vtkPartitionedDataSetCollection *p_output)
+{
+    p_output->Initialize();
+    p_output->SetNumberOfPartitionedDataSets(p_collection->GetNumberOfPartitionedDataSets());
+    for (unsigned int w_index = 0; w_index < p_collection->GetNumberOfPartitionedDataSets(); ++w_index)
+    {
+        vtkPartitionedDataSet *const w_source = p_collection->GetPartitionedDataSet(w_index);
+        if (w_source == nullptr)
+        {
+            continue;
+        }
+        vtkSmartPointer<vtkPartitionedDataSet> w_partitionedDataSet = vtkSmartPointer<vtkPartitionedDataSet>::New();
+        w_partitionedDataSet->SetNumberOfPartitions(w_source->GetNumberOfPartitions());
+        w_partitionedDataSet->GetFieldData()->ShallowCopy(w_source->GetFieldData());
+        for (unsigned int w_partitionIndex = 0; w_partitionIndex < w_source->GetNumberOfPartitions(); ++w_partitionIndex)
         {
-            // load mapper representation
-            if (_nodeIdToMapper.find(w_nodeSelection) != _nodeIdToMapper.end())
+            vtkDataObject *const w_partition = w_source->GetPartitionAsDataObject(w_partitionIndex);
+            if (w_partition != nullptr)
             {
-                _output->SetPartitionedDataSet(w_PartitionIndex, _nodeIdToMapper[w_nodeSelection]->getOutput());
-                _output->GetMetaData(w_PartitionIndex)->Set(vtkCompositeDataSet::NAME(), _nodeIdToMapper[w_nodeSelection]->getTitle() + '(' + _nodeIdToMapper[w_nodeSelection]->getUuid() + ')');
-                GetAssembly()->AddDataSetIndex(w_nodeSelection, w_PartitionIndex + 1); // attach hierarchy to assembly
-                w_PartitionIndex++;
+                vtkSmartPointer<vtkDataObject> w_copy = vtkSmartPointer<vtkDataObject>::Take(w_partition->NewInstance());
+                w_copy->ShallowCopy(w_partition);
+                w_partitionedDataSet->SetPartition(w_partitionIndex, w_copy);
             }
         }
+        p_output->SetPartitionedDataSet(w_index, w_partitionedDataSet);
+        if (p_collection->HasMetaData(w_index))
+        {
+            p_output->GetMetaData(w_index)->Copy(p_collection->GetMetaData(w_index));
+        }
     }
 
-    _output->Modified();
-    return _output;
+    // the assembly of the repository gets the dataset indices of the next requests
+    vtkSmartPointer<vtkDataAssembly> w_assembly = vtkSmartPointer<vtkDataAssembly>::New();
+    w_assembly->DeepCopy(p_collection->GetDataAssembly());
+    p_output->SetDataAssembly(w_assembly);
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::updateOutput()
+{
+    // the datasets of the selected mappers, in the selection order
+    std::vector<std::pair<uint32_t, CommonAbstractObjectToVtkPartitionedDataSet *>> w_mappers;
+    for (const uint32_t w_nodeSelection : _currentSelection)
+    {
+        const TreeViewNodeType w_type = getNodeInfo(w_nodeSelection).type;
+
+        if (getMapperType(w_type) == MapperType::MapperSet && _nodeIdToMapperSet.find(w_nodeSelection) != _nodeIdToMapperSet.end())
+        {
+            for (auto *w_partition : _nodeIdToMapperSet[w_nodeSelection]->getMapperSet())
+            {
+                w_mappers.push_back(std::make_pair(w_nodeSelection, w_partition));
+            }
+        }
+        else if (getMapperType(w_type) == MapperType::Mapper && _nodeIdToMapper.find(w_nodeSelection) != _nodeIdToMapper.end())
+        {
+            w_mappers.push_back(std::make_pair(w_nodeSelection, _nodeIdToMapper[w_nodeSelection]));
+        }
+    }
+    std::set<std::pair<uint32_t, vtkPartitionedDataSet *>> w_wantedPartitions;
+    for (const auto &w_mapper : w_mappers)
+    {
+        w_wantedPartitions.insert(std::make_pair(w_mapper.first, w_mapper.second->getOutput()));
+    }
+
+    // remove the partitions which are not wanted anymore, the next ones being shifted
+    bool w_changed = false;
+    std::vector<std::pair<uint32_t, vtkPartitionedDataSet *>> w_partitions;
+    std::map<unsigned int, unsigned int> w_datasetIndices; // old to new dataset index in the assembly
+    for (size_t w_index = 0; w_index < _outputPartitions.size(); ++w_index)
+    {
+        if (w_wantedPartitions.find(_outputPartitions[w_index]) != w_wantedPartitions.end())
+        {
+            w_datasetIndices[static_cast<unsigned int>(w_index + 1)] = static_cast<unsigned int>(w_partitions.size() + 1);
+            w_partitions.push_back(_outputPartitions[w_index]);
+        }
+    }
+    if (w_partitions.size() != _outputPartitions.size())
+    {
+        for (size_t w_index = _outputPartitions.size(); w_index-- > 0;)
+        {
+            if (w_wantedPartitions.find(_outputPartitions[w_index]) == w_wantedPartitions.end())
+            {
+                _output->RemovePartitionedDataSet(static_cast<unsigned int>(w_index));
+            }
+        }
+        GetAssembly()->RemapDataSetIndices(w_datasetIndices, true);
+        w_changed = true;
+    }
+
+    // append the new partitions
+    const std::set<std::pair<uint32_t, vtkPartitionedDataSet *>> w_keptPartitions(w_partitions.begin(), w_partitions.end());
+    for (const auto &w_mapper : w_mappers)
+    {
+        const std::pair<uint32_t, vtkPartitionedDataSet *> w_partition(w_mapper.first, w_mapper.second->getOutput());
+        if (w_keptPartitions.find(w_partition) == w_keptPartitions.end())
+        {
+            const unsigned int w_partitionIndex = static_cast<unsigned int>(w_partitions.size());
+            _output->SetPartitionedDataSet(w_partitionIndex, w_partition.second);
+            _output->GetMetaData(w_partitionIndex)->Set(vtkCompositeDataSet::NAME(), w_mapper.second->getTitle() + '(' + w_mapper.second->getUuid() + ')');
+            GetAssembly()->AddDataSetIndex(w_partition.first, w_partitionIndex + 1); // attach hierarchy to assembly
+            w_partitions.push_back(w_partition);
+            w_changed = true;
+        }
+    }
+    _outputPartitions = w_partitions;
+
+    // the partitions whose data changed have already been modified by their mapper
+    if (w_changed)
+    {
+        _output->Modified();
+    }
 }
 
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setMarkerOrientation(bool orientation)
 {
-    _markerOrientation = orientation;
+    if (_markerOrientation != orientation)
+    {
+        _markerOrientation = orientation;
+        reloadMarkers();
+    }
 }
 
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setMarkerSize(uint32_t size)
 {
-    _markerSize = size;
+    if (_markerSize != size)
+    {
+        _markerSize = size;
+        reloadMarkers();
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::reloadMarkers()
+{
+    for (auto w_it = _loadedSelection.begin(); w_it != _loadedSelection.end();)
+    {
+        if (getNodeInfo(*w_it).type == TreeViewNodeType::WellboreMarker)
+        {
+            w_it = _loadedSelection.erase(w_it);
+        }
+        else
+        {
+            ++w_it;
+        }
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setGeometryPrecision(GeometryPrecision p_precision)
+{
+    if (_geometryPrecision != p_precision)
+    {
+        _geometryPrecision = p_precision;
+        // the points of the loaded mappers must be rebuilt relatively to a new origin
+        clearMappers();
+        _geometryOrigin = std::make_shared<std::array<double, 3>>();
+        _geometryOrigin->fill(std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setIjkPartitioning(IjkPartitioning p_partitioning)
+{
+    if (_ijkPartitioning != p_partitioning)
+    {
+        _ijkPartitioning = p_partitioning;
+        // the K range of each process is computed at the construction of the IJK grid mappers
+        clearMappers();
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setGhostCellLayer(bool p_ghostCellLayer)
+{
+    if (_ghostCellLayer != p_ghostCellLayer)
+    {
+        _ghostCellLayer = p_ghostCellLayer;
+        // the cells of each process are chosen at the loading of the grid mappers
+        clearMappers();
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setSubRepresentationPointCompaction(bool p_compaction)
+{
+    if (_subRepPointCompaction != p_compaction)
+    {
+        _subRepPointCompaction = p_compaction;
+        // the points of the subrepresentations are chosen at their loading
+        clearMappers();
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::clearMappers()
+{
+    for (const auto &w_keyVal : _nodeIdToMapper)
+    {
+        delete w_keyVal.second;
+    }
+    _nodeIdToMapper.clear();
+    for (const auto &w_keyVal : _nodeIdToMapperSet)
+    {
+        delete w_keyVal.second;
+    }
+    _nodeIdToMapperSet.clear();
+    // all the selected nodes are loaded again at the next request
+    _loadedSelection.clear();
+    // the pieces of the properties may change with the mappers
+    _propertyUuidToRanges.clear();
+    _timeSeriesPrefetcher.clear();
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::applyPropertyReadOptions(ResqmlAbstractRepresentationToVtkPartitionedDataSet *p_representation) const
+{
+    p_representation->setMaxReadBufferSize(static_cast<uint64_t>(_propertyReadMemoryLimit) * 1024 * 1024);
+    p_representation->setDeferredPropertyLoading(_deferredPropertyLoading);
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::cachePropertyRanges(ResqmlAbstractRepresentationToVtkPartitionedDataSet *p_representation, const std::string &p_propertyUuid)
+{
+    ResqmlPropertyToVtkDataArray *w_property = p_representation->getDataArray(p_propertyUuid);
+    if (w_property == nullptr)
+    {
+        return;
+    }
+    const auto w_it = _propertyUuidToRanges.find(p_propertyUuid);
+    if (w_it != _propertyUuidToRanges.end())
+    {
+        w_property->setRanges(w_it->second);
+    }
+    else
+    {
+        const std::vector<double> w_ranges = w_property->getRanges();
+        if (!w_ranges.empty())
+        {
+            _propertyUuidToRanges[p_propertyUuid] = w_ranges;
+        }
+    }
+}
+
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::findNode(const std::string &p_nodeName) const
+{
+    const auto w_it = _nodeNameToNodeId.find(p_nodeName);
+    return w_it != _nodeNameToNodeId.end() ? w_it->second : -1;
+}
+
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addNode(const std::string &p_nodeName, int p_parentNodeId)
+{
+    const int w_nodeId = _output->GetDataAssembly()->AddNode(p_nodeName.c_str(), p_parentNodeId);
+    if (w_nodeId != -1)
+    {
+        // as FindFirstNodeWithName, the first node added with a name is kept
+        _nodeNameToNodeId.insert(std::make_pair(p_nodeName, w_nodeId));
+
+        if (static_cast<size_t>(w_nodeId) >= _nodeInfos.size())
+        {
+            _nodeInfos.resize(w_nodeId + 1);
+        }
+        NodeInfo &w_nodeInfo = _nodeInfos[w_nodeId];
+        w_nodeInfo = NodeInfo();
+        w_nodeInfo.parent = p_parentNodeId;
+        w_nodeInfo.dataParent = p_parentNodeId;
+        w_nodeInfo.uuid = p_nodeName.substr(1);
+    }
+    return w_nodeId;
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setNodeType(int p_nodeId, TreeViewNodeType p_type)
+{
+    // the attribute is kept for the tree view of the readers
+    _output->GetDataAssembly()->SetAttribute(p_nodeId, "type", std::to_string(static_cast<int>(p_type)).c_str());
+    if (p_nodeId < 0 || static_cast<size_t>(p_nodeId) >= _nodeInfos.size())
+    {
+        return;
+    }
+
+    NodeInfo &w_nodeInfo = _nodeInfos[p_nodeId];
+    w_nodeInfo.type = p_type;
+    // the collections only group their children in the tree view
+    w_nodeInfo.dataParent = w_nodeInfo.parent;
+    while (w_nodeInfo.dataParent > 0 && _nodeInfos[w_nodeInfo.dataParent].type == TreeViewNodeType::Collection)
+    {
+        w_nodeInfo.dataParent = _nodeInfos[w_nodeInfo.dataParent].parent;
+    }
+}
+
+const ResqmlDataRepositoryToVtkPartitionedDataSetCollection::NodeInfo &ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getNodeInfo(int p_nodeId) const
+{
+    static const NodeInfo w_unknownNode;
+    return p_nodeId >= 0 && static_cast<size_t>(p_nodeId) < _nodeInfos.size() ? _nodeInfos[p_nodeId] : w_unknownNode;
+}
+
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::findNodeByPath(const std::string &p_path) const
+{
+    const int w_nodeId = findNode(p_path.substr(p_path.find_last_of('/') + 1));
+    if (w_nodeId != -1 && _output->GetDataAssembly()->GetNodePath(w_nodeId) == p_path)
+    {
+        return w_nodeId;
+    }
+    // the root, or a node whose name is not unique
+    return _output->GetDataAssembly()->GetFirstNodeByPath(p_path.c_str());
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::removeNode(int p_nodeId)
+{
+    vtkDataAssembly *const w_assembly = _output->GetDataAssembly();
+    std::vector<int> w_removedNodes = w_assembly->GetChildNodes(p_nodeId, true);
+    w_removedNodes.push_back(p_nodeId);
+    for (const int w_nodeId : w_removedNodes)
+    {
+        const auto w_it = _nodeNameToNodeId.find(w_assembly->GetNodeName(w_nodeId));
+        if (w_it != _nodeNameToNodeId.end() && w_it->second == w_nodeId)
+        {
+            _nodeNameToNodeId.erase(w_it);
+        }
+        _nodeInfos[w_nodeId] = NodeInfo();
+    }
+    w_assembly->RemoveNode(p_nodeId);
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setTimeStepPrefetchWindow(uint32_t p_stepCount)
+{
+    if (_timeStepPrefetchWindow != p_stepCount)
+    {
+        _timeStepPrefetchWindow = p_stepCount;
+        _timeSeriesPrefetcher.cancel();
+        _timeSeriesPrefetcher.setCapacity(4 * (_timeStepPrefetchWindow + 1));
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setThreadCount(uint32_t p_threadCount)
+{
+    // applied at the next request
+    _threadCount = p_threadCount;
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setPropertyReadMemoryLimit(uint32_t p_megabytes)
+{
+    // applied to the properties selected afterwards
+    _propertyReadMemoryLimit = p_megabytes;
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setDeferredPropertyLoading(bool p_deferred)
+{
+    // applied to the properties selected afterwards
+    _deferredPropertyLoading = p_deferred;
 }
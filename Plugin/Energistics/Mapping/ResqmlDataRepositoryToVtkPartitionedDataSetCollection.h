@@ -20,11 +20,17 @@ under the License.
 #define __ResqmlDataRepositoryToVtkPartitionedDataSetCollection_h
 
 // include system
+#include <array>
+#include <memory>
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <vtkSmartPointer.h>
+#include <vtkPartitionedDataSet.h>
 #include <vtkPartitionedDataSetCollection.h>
 #include <vtkMultiProcessController.h>
 
@@ -33,9 +39,11 @@ under the License.
 #endif
 
 #include "../Tools/enum.h"
+#include "ResqmlTimeSeriesPrefetcher.h"
 
 namespace common
 {
+	class AbstractObject;
 	class DataObjectRepository;
 }
 
@@ -87,10 +95,69 @@ public:
 	void setMarkerOrientation(bool p_orientation);
 	void setMarkerSize(uint32_t p_size);
 
+	// Multithreading Options
+	/**
+	 * Cap the number of threads used by the SMP loops of the mappers during the requests, without changing the one of the other VTK filters.
+	 * 0 means the VTK SMP backend default (all the cores or VTK_SMP_MAX_THREADS).
+	 */
+	void setThreadCount(uint32_t p_threadCount);
+	/**
+	 * Cap the temporary memory of each partial property read, in megabytes.
+	 */
+	void setPropertyReadMemoryLimit(uint32_t p_megabytes);
+	/**
+	 * Only read the values of the properties selected afterwards when a filter accesses them.
+	 */
+	void setDeferredPropertyLoading(bool p_deferred);
+	/**
+	 * Read on a background thread the values of the time series properties for this count of steps after the requested one.
+	 * The cache keeps 4 * (p_stepCount + 1) arrays : the steps ahead and the ones already displayed.
+	 */
+	void setTimeStepPrefetchWindow(uint32_t p_stepCount);
+
+	// Geometry Options
+	/**
+	 * In float precision, all the points of the collection are relative to a common origin which is stored in the field data of each dataset.
+	 * Changing the precision reloads all the mappers.
+	 */
+	void setGeometryPrecision(GeometryPrecision p_precision);
+
+	// Parallel Options
+	/**
+	 * Choose how the K layers of the IJK grids are shared among the processes.
+	 * Changing the partitioning reloads all the mappers.
+	 */
+	void setIjkPartitioning(IjkPartitioning p_partitioning);
+	/**
+	 * Add to the grid piece of each process a layer of ghost cells (vtkGhostType) from the neighbour pieces.
+	 * Changing it reloads all the mappers.
+	 */
+	void setGhostCellLayer(bool p_ghostCellLayer);
+
+	// SubRepresentation Options
+	/**
+	 * Only give to the subrepresentations the points of the supporting grid that their cells reference, with their vtkOriginalPointIds.
+	 * Changing it reloads all the mappers.
+	 */
+	void setSubRepresentationPointCompaction(bool p_compaction);
+
 	vtkPartitionedDataSetCollection *getVtkPartitionedDatasSetCollection(const double p_time, const uint32_t p_nbProcess = 1, const uint32_t p_processId = 0);
 
+	/**
+	 * Give a collection returned by getVtkPartitionedDatasSetCollection to the output of a reader without copying the arrays.
+	 * Each dataset of the output is a new instance sharing the arrays of the mapper one : the mappers can then add or remove arrays without changing the output.
+	 * The mappers never change the values of an array once it is given : they replace the array, or the dataset when they load it again.
+	 */
+	static void shallowCopyOutput(vtkPartitionedDataSetCollection *p_collection, vtkPartitionedDataSetCollection *p_output);
+
 	std::vector<double> getTimes() { return _timesStep; };
 
+	/**
+	 * Same as vtkDataAssembly::GetFirstNodeByPath but without walking the whole tree.
+	 * @return the node of a selector path, for instance /data/_uuid/_uuid, -1 if it does not exist
+	 */
+	int findNodeByPath(const std::string &p_path) const;
+
 	/**
 	 * @return selection parent
 	 */
@@ -114,23 +181,53 @@ private:
 	void selectNodeIdChildren(uint32_t p_nodeId);
 
 	/**
-	 * delete _oldSelection mapper
+	 * delete the mappers and the data of the unselected nodes
+	 */
+	void deleteMapper(const std::set<uint32_t> &p_nodeIds);
+
+	/**
+	 * Load the mappers and the data of the selection changes since the last request, in the SMP scope of the thread count.
 	 */
-	void deleteMapper(double p_time);
+	void loadSelection(const double p_time, const uint32_t p_nbProcess, const uint32_t p_processId);
+
+	/**
+	 * In float precision, initialize the shared geometry origin if it is not yet, the same way on all the processes whatever the pieces they load.
+	 */
+	void initGeometryOrigin();
+
 	/**
 	 * initialize _nodeIdToMapperSet
 	 */
-	void initMapperSet(const TreeViewNodeType p_type, const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId);
+	void initMapperSet(const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId);
 	/**
 	 * initialize and load _nodeIdToMapper
 	 */
-	void loadMapper(const TreeViewNodeType p_type, const uint32_t p_nodeId,const uint32_t p_nbProcess, const uint32_t p_processId);
-	void loadRepresentationMapper(const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId);
-	void loadWellboreTrajectoryMapper(const uint32_t p_nodeId);
+	void loadMapper(const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId);
 	/**
  * add data to parent nodeId
  */
 	void addDataToParent(const TreeViewNodeType p_type, const uint32_t p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId, const double p_time);
+	/**
+	 * Remove from _output the partitions of the unselected mappers and append the ones of the new mappers, updating the dataset indices of the assembly.
+	 * The partitions kept are not modified.
+	 */
+	void updateOutput();
+	/**
+	 * the selected markers are updated at the next request with the new orientation and size
+	 */
+	void reloadMarkers();
+	/**
+	 * delete all mappers, they are reloaded from the current selection at next request
+	 */
+	void clearMappers();
+	/**
+	 * Give the property read options of this repository to a representation before adding or prefetching some of its properties.
+	 */
+	void applyPropertyReadOptions(ResqmlAbstractRepresentationToVtkPartitionedDataSet *p_representation) const;
+	/**
+	 * Give to a property just added to a representation the ranges cached for its UUID, else cache its ranges.
+	 */
+	void cachePropertyRanges(ResqmlAbstractRepresentationToVtkPartitionedDataSet *p_representation, const std::string &p_propertyUuid);
 
 	// This function replaces the VTK function vtkDataAssembly::MakeValidNodeName(),
 	// which has a bug in the sorted_valid_chars array. The '.' character is placed
@@ -142,8 +239,77 @@ private:
 	// node name from a given string.
 	std::string MakeValidNodeName(const char *p_name);
 
+	/**
+	 * @return the id of the first node added to the assembly with this name, -1 if there is none
+	 */
+	int findNode(const std::string &p_nodeName) const;
+	/**
+	 * Add a node to the assembly, indexed by its name.
+	 */
+	int addNode(const std::string &p_nodeName, int p_parentNodeId);
+	/**
+	 * Remove a node and its children from the assembly and from the index.
+	 */
+	void removeNode(int p_nodeId);
+
+	/**
+	 * The kind of mapper of a data object and how to create it : only one of the two functions is set.
+	 */
+	struct MapperFactory
+	{
+		MapperKind kind;
+		CommonAbstractObjectToVtkPartitionedDataSet *(*newMapper)(ResqmlDataRepositoryToVtkPartitionedDataSetCollection &p_repository, common::AbstractObject *p_object, uint32_t p_nbProcess, uint32_t p_processId);
+		CommonAbstractObjectSetToVtkPartitionedDataSetSet *(*newMapperSet)(ResqmlDataRepositoryToVtkPartitionedDataSetCollection &p_repository, common::AbstractObject *p_object, uint32_t p_nbProcess, uint32_t p_processId);
+	};
+	/**
+	 * @return the factory of each supported XML tag, "SubRepresentation/" followed by the XML tag of the supporting representation for a subrepresentation
+	 */
+	static const std::unordered_map<std::string, MapperFactory> &getMapperFactories();
+	/**
+	 * @return the factory of the data object of a node, looked up once and then kept in the node table, nullptr if it is not supported
+	 */
+	const MapperFactory *getMapperFactory(uint32_t p_nodeId);
+
+	/**
+	 * What the requests need to know about a node of the assembly, filled when the tree is built.
+	 */
+	struct NodeInfo
+	{
+		struct Perforation
+		{
+			std::string connection;
+			std::string label;
+			double skin;
+			double diameter;
+		};
+
+		TreeViewNodeType type = TreeViewNodeType::Unknown;
+		int parent = -1;
+		int dataParent = -1;							 // nearest ancestor which is not a collection
+		std::string uuid;								 // node name without its leading underscore
+		std::shared_ptr<const Perforation> perforation; // only for the perforation nodes
+		const MapperFactory *mapperFactory = nullptr;	 // set at the first load of the mapper
+	};
+	/**
+	 * Set the type of a node in the assembly and in the node table.
+	 */
+	void setNodeType(int p_nodeId, TreeViewNodeType p_type);
+	/**
+	 * @return the entry of a node in the node table, an unknown node if it does not exist
+	 */
+	const NodeInfo &getNodeInfo(int p_nodeId) const;
+
 	bool _markerOrientation;
 	uint32_t _markerSize;
+	uint32_t _threadCount;
+	uint32_t _propertyReadMemoryLimit;
+	bool _deferredPropertyLoading;
+	uint32_t _timeStepPrefetchWindow;
+	GeometryPrecision _geometryPrecision;
+	IjkPartitioning _ijkPartitioning;
+	bool _ghostCellLayer;
+	bool _subRepPointCompaction;
+	std::shared_ptr<std::array<double, 3>> _geometryOrigin; // shared by all mappers in float precision
 
 	common::DataObjectRepository *_repository;
 
@@ -152,11 +318,25 @@ private:
 	std::map<uint32_t, CommonAbstractObjectToVtkPartitionedDataSet *> _nodeIdToMapper;		   // index of VtkDataAssembly to CommonAbstractObjectToVtkPartitionedDataSet
 	std::map<uint32_t, CommonAbstractObjectSetToVtkPartitionedDataSetSet *> _nodeIdToMapperSet; // index of VtkDataAssembly to CommonAbstractObjectSetToVtkPartitionedDataSetSet
 
+	// node name ("_" + uuid for a data object) to node id of the assembly, since vtkDataAssembly::FindFirstNodeWithName walks the whole tree
+	std::unordered_map<std::string, int> _nodeNameToNodeId;
+	// node id of the assembly to its type, uuid, parents and attributes, so that the requests do not parse the attributes of the assembly
+	std::vector<NodeInfo> _nodeInfos;
+
+	// the minimum and maximum of each component of the properties already loaded, emptied with the mappers
+	std::map<std::string, std::vector<double>> _propertyUuidToRanges;
+
+	// the values of the time series steps read in advance or already displayed, emptied with the mappers
+	ResqmlTimeSeriesPrefetcher _timeSeriesPrefetcher;
+
 	//\/          uuid             title            index        prop_uuid
 	std::map<std::string, std::map<std::string, std::map<double, std::string>>> _timeSeriesUuidAndTitleToIndexAndPropertiesUuid;
 
 	std::set<uint32_t> _currentSelection;
-	std::set<uint32_t> _oldSelection;
+	std::set<uint32_t> _loadedSelection; // the selection of _output
+	double _loadedTime;					 // the time step of _output
+	// node of the assembly and dataset of each partition of _output
+	std::vector<std::pair<uint32_t, vtkPartitionedDataSet *>> _outputPartitions;
 
 	std::set<std::string> _files;
 
@@ -0,0 +1,253 @@
+﻿/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#ifndef __ResqmlDeferredDataArray_h
+#define __ResqmlDeferredDataArray_h
+
+// include system
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// include VTK library
+#include <vtkAOSDataArrayTemplate.h>
+#include <vtkGenericDataArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationDoubleVectorKey.h>
+#include <vtkInformationInformationVectorKey.h>
+#include <vtkInformationVector.h>
+#include <vtkObjectFactory.h>
+#include <vtkOutputWindow.h>
+#include <vtkSmartPointer.h>
+
+/** @brief	a data array whose values are only loaded when they are accessed for the first time
+ *
+ * The values are loaded once (even if several threads access them together) in a vtkAOSDataArrayTemplate, to which all the accesses are then forwarded.
+ * Until then, the range of each component is the one given with the loader, or stored in the information of the array, so that the pipeline information does not load the values.
+ * A range which is not known is empty ([VTK_DOUBLE_MAX, VTK_DOUBLE_MIN]) until the values are loaded.
+ * If the loader returns no array (for instance once the mapper which created it is deleted), the values are set to 0.
+ */
+template <typename ValueTypeT>
+class ResqmlDeferredDataArray : public vtkGenericDataArray<ResqmlDeferredDataArray<ValueTypeT>, ValueTypeT>
+{
+	typedef vtkGenericDataArray<ResqmlDeferredDataArray<ValueTypeT>, ValueTypeT> GenericDataArrayType;
+
+public:
+	vtkTemplateTypeMacro(ResqmlDeferredDataArray<ValueTypeT>, GenericDataArrayType);
+	typedef typename Superclass::ValueType ValueType;
+
+	static ResqmlDeferredDataArray *New()
+	{
+		VTK_STANDARD_NEW_BODY(ResqmlDeferredDataArray<ValueTypeT>);
+	}
+
+	/**
+	 * Set the shape of the array and the function which loads its values.
+	 *
+	 * @param p_loader	Returns the values in an array of the same shape, of any VTK data type, nullptr if they can no longer be read.
+	 * @param p_ranges	The minimum and maximum of each component, returned by ComputeRange until the values are loaded. Empty if unknown.
+	 */
+	void SetLoader(vtkIdType p_tupleCount, int p_componentCount, const std::function<vtkSmartPointer<vtkDataArray>()> &p_loader, const std::vector<double> &p_ranges)
+	{
+		this->SetNumberOfComponents(p_componentCount);
+		this->Size = p_tupleCount * p_componentCount;
+		this->MaxId = this->Size - 1;
+		this->Loader = p_loader;
+		this->Ranges = p_ranges;
+		this->Modified();
+	}
+
+	/**
+	 * Tell if the values have been loaded.
+	 */
+	bool IsLoaded() const { return this->Loaded; }
+
+	ValueType GetValue(vtkIdType valueIdx) const
+	{
+		return this->GetLoadedValues()->GetValue(valueIdx);
+	}
+
+	void SetValue(vtkIdType valueIdx, ValueType value)
+	{
+		this->GetLoadedValues()->SetValue(valueIdx, value);
+	}
+
+	void GetTypedTuple(vtkIdType tupleIdx, ValueType *tuple) const
+	{
+		this->GetLoadedValues()->GetTypedTuple(tupleIdx, tuple);
+	}
+
+	void SetTypedTuple(vtkIdType tupleIdx, const ValueType *tuple)
+	{
+		this->GetLoadedValues()->SetTypedTuple(tupleIdx, tuple);
+	}
+
+	ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+	{
+		return this->GetLoadedValues()->GetTypedComponent(tupleIdx, comp);
+	}
+
+	void SetTypedComponent(vtkIdType tupleIdx, int comp, ValueType value)
+	{
+		this->GetLoadedValues()->SetTypedComponent(tupleIdx, comp, value);
+	}
+
+	void *GetVoidPointer(vtkIdType valueIdx) override
+	{
+		return this->GetLoadedValues()->GetVoidPointer(valueIdx);
+	}
+
+	void ComputeRange(double range[2], int comp) override
+	{
+		if (!this->GetRangeBeforeLoading(range, comp, false))
+		{
+			this->Superclass::ComputeRange(range, comp);
+		}
+	}
+
+	void ComputeFiniteRange(double range[2], int comp) override
+	{
+		if (!this->GetRangeBeforeLoading(range, comp, true))
+		{
+			this->Superclass::ComputeFiniteRange(range, comp);
+		}
+	}
+
+protected:
+	ResqmlDeferredDataArray() : Loaded(false) {}
+	~ResqmlDeferredDataArray() override = default;
+
+	bool AllocateTuples(vtkIdType numTuples)
+	{
+		// The current values are discarded : there is no need to load them
+		this->Loader = nullptr;
+		vtkAOSDataArrayTemplate<ValueType> *values = this->GetLoadedValues();
+		values->SetNumberOfComponents(this->NumberOfComponents);
+		return values->Resize(numTuples) != 0;
+	}
+
+	bool ReallocateTuples(vtkIdType numTuples)
+	{
+		vtkAOSDataArrayTemplate<ValueType> *values = this->GetLoadedValues();
+		values->SetNumberOfComponents(this->NumberOfComponents);
+		return values->Resize(numTuples) != 0;
+	}
+
+private:
+	ResqmlDeferredDataArray(const ResqmlDeferredDataArray &) = delete;
+	void operator=(const ResqmlDeferredDataArray &) = delete;
+
+	friend class vtkGenericDataArray<ResqmlDeferredDataArray<ValueTypeT>, ValueTypeT>;
+
+	/**
+	 * Get the range of a component, or of the L2 norm of the tuples if comp < 0, as long as the values are not loaded.
+	 * The range given with the loader comes first, then the one stored in the information of the array, else the range is empty.
+	 *
+	 * @return false if the values are loaded : the range is then computed from them.
+	 */
+	bool GetRangeBeforeLoading(double range[2], int comp, bool finite)
+	{
+		if (this->Loaded)
+		{
+			return false;
+		}
+		if (comp < 0 && this->NumberOfComponents == 1)
+		{
+			comp = 0;
+		}
+
+		// The L2 norm range follows the component ranges
+		const size_t rangeIndex = comp < 0 ? static_cast<size_t>(this->NumberOfComponents) : static_cast<size_t>(comp);
+		if (2 * rangeIndex + 1 < this->Ranges.size())
+		{
+			range[0] = this->Ranges[2 * rangeIndex];
+			range[1] = this->Ranges[2 * rangeIndex + 1];
+			return true;
+		}
+
+		vtkInformation *info = this->GetInformation();
+		if (comp < 0)
+		{
+			vtkInformationDoubleVectorKey *key = finite ? vtkDataArray::L2_NORM_FINITE_RANGE() : vtkDataArray::L2_NORM_RANGE();
+			if (info->Has(key))
+			{
+				info->Get(key, range);
+				return true;
+			}
+		}
+		else if (info->Has(vtkDataArray::PER_COMPONENT()) && comp < info->Get(vtkDataArray::PER_COMPONENT())->GetNumberOfInformationObjects())
+		{
+			vtkInformation *componentInfo = info->Get(vtkDataArray::PER_COMPONENT())->GetInformationObject(comp);
+			vtkInformationDoubleVectorKey *key = finite ? vtkDataArray::COMPONENT_FINITE_RANGE() : vtkDataArray::COMPONENT_RANGE();
+			if (componentInfo != nullptr && componentInfo->Has(key))
+			{
+				componentInfo->Get(key, range);
+				return true;
+			}
+		}
+
+		range[0] = VTK_DOUBLE_MAX;
+		range[1] = VTK_DOUBLE_MIN;
+		return true;
+	}
+
+	/**
+	 * Load the values at the first call.
+	 */
+	vtkAOSDataArrayTemplate<ValueType> *GetLoadedValues() const
+	{
+		std::call_once(this->LoadFlag, [this]()
+					   {
+						   vtkSmartPointer<vtkDataArray> loaded = this->Loader ? this->Loader() : nullptr;
+						   // The loaded array is shared if it has the same type, else it is converted
+						   this->Values = vtkAOSDataArrayTemplate<ValueType>::FastDownCast(loaded.Get());
+						   if (this->Values == nullptr)
+						   {
+							   this->Values = vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>>::New();
+							   this->Values->SetNumberOfComponents(this->NumberOfComponents);
+							   if (loaded != nullptr)
+							   {
+								   this->Values->DeepCopy(loaded);
+							   }
+						   }
+						   if (this->Loader && this->Values->GetNumberOfValues() != this->Size)
+						   {
+							   const std::string name = this->Name == nullptr ? "" : this->Name;
+							   vtkOutputWindowDisplayWarningText((loaded == nullptr
+																	  ? "The values of " + name + " can no longer be read : they are set to 0.\n"
+																	  : "The loaded values of " + name + " do not match the size of the array.\n")
+																	 .c_str());
+							   const vtkIdType loadedValueCount = (std::min)(this->Values->GetNumberOfValues(), this->Size);
+							   this->Values->SetNumberOfValues(this->Size);
+							   std::fill(this->Values->GetPointer(loadedValueCount), this->Values->GetPointer(0) + this->Size, ValueType());
+						   }
+						   this->Loader = nullptr; // releases what the loader holds
+						   this->Loaded = true; });
+		return this->Values;
+	}
+
+	mutable std::function<vtkSmartPointer<vtkDataArray>()> Loader;
+	mutable std::once_flag LoadFlag;
+	mutable std::atomic<bool> Loaded;
+	mutable vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>> Values;
+	std::vector<double> Ranges;
+};
+#endif
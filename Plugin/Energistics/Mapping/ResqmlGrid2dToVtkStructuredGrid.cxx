@@ -73,32 +73,33 @@ void ResqmlGrid2dToVtkStructuredGrid::loadVtkObject()
 	std::unique_ptr<double[]> z(new double[nbNodeI * nbNodeJ]);
 	grid2D->getZValuesInGlobalCrs(z.get());
 
-	vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
 	vtkSmartPointer<vtkCellArray> vertices = vtkSmartPointer<vtkCellArray>::New();
 
 	std::vector< vtkIdType> blankPts;
 
+	double *allXyzPoints = new double[_pointCount * 3]; // Will be deleted by VTK
 	for (uint64_t j = 0; j < nbNodeJ; ++j)
 	{
 		for (uint64_t i = 0; i < nbNodeI; ++i)
 		{
 			const size_t ptId = i + j * nbNodeI;
 
-				vtkIdType pid = points->InsertNextPoint(
-					originX + i * XIOffset + j * XJOffset,
-					originY + i * YIOffset + j * YJOffset,
-					z[ptId] * zIndice);
+				allXyzPoints[ptId * 3] = originX + i * XIOffset + j * XJOffset;
+				allXyzPoints[ptId * 3 + 1] = originY + i * YIOffset + j * YJOffset;
+				allXyzPoints[ptId * 3 + 2] = z[ptId] * zIndice;
 				if (std::isnan(z[ptId])) {
-					blankPts.push_back(pid);
+					blankPts.push_back(ptId);
 				}
 		}
 	}
 
-	structuredGrid->SetPoints(points);
+	structuredGrid->SetPoints(createVtkPoints(allXyzPoints, _pointCount));
 	for (vtkIdType pid: blankPts) {
 		structuredGrid->BlankPoint(pid);
 	}
 
+	addGeometryOriginToFieldData(structuredGrid);
+
 	_vtkData->SetPartition(0, structuredGrid);
 	_vtkData->Modified();
 }
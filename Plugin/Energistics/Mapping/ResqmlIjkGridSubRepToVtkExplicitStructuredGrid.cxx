@@ -18,6 +18,7 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "Mapping/ResqmlIjkGridSubRepToVtkExplicitStructuredGrid.h"
 
+#include <algorithm>
 #include <array>
 
 // include VTK library
@@ -26,7 +27,9 @@ under the License.
 #include <vtkDataArray.h>
 #include <vtkDoubleArray.h>
 #include <vtkEmptyCell.h>
-#include <vtkHexahedron.h>
+#include <vtkCellArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkSMPTools.h>
 #include <vtkUnstructuredGrid.h>
 
 // include FESAPI
@@ -38,12 +41,13 @@ under the License.
 #include "ResqmlIjkGridToVtkExplicitStructuredGrid.h"
 
 //----------------------------------------------------------------------------
-ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(const RESQML2_NS::SubRepresentation* subRep, ResqmlIjkGridToVtkExplicitStructuredGrid* support, uint32_t p_procNumber, uint32_t p_maxProc)
+ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(const RESQML2_NS::SubRepresentation* subRep, ResqmlIjkGridToVtkExplicitStructuredGrid* support, uint32_t p_procNumber, uint32_t p_maxProc, bool p_compactPoints)
 
 	: ResqmlAbstractRepresentationToVtkPartitionedDataSet(subRep,
 		p_procNumber,
 		p_maxProc),
-	mapperIjkGrid(support)
+	mapperIjkGrid(support),
+	_compactPoints(p_compactPoints)
 {
 	_iCellCount = subRep->getElementCountOfPatch(0);
 	_pointCount = subRep->getSupportingRepresentation(0)->getXyzPointCountOfAllPatches();
@@ -77,11 +81,8 @@ void ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::loadVtkObject()
 		return;
 	}
 
-	// Create and set the list of points of the vtkUnstructuredGrid
 	vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
 
-	vtk_unstructuredGrid->SetPoints(this->getMapperVtkPoint());
-
 	// Define hexahedron node ordering according to Paraview convention : https://lorensen.github.io/VTKExamples/site/VTKBook/05Chapter5/#Figure%205-3
 	std::array<unsigned int, 8> correspondingResqmlCornerId = { 0, 1, 2, 3, 4, 5, 6, 7 };
 	if (supportingGrid->isRightHanded())
@@ -91,9 +92,6 @@ void ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::loadVtkObject()
 
 	supportingGrid->loadSplitInformation();
 
-	// Create and set the list of hexahedra of the vtkUnstructuredGrid based on the list of points already set
-	uint64_t cellIndex = 0;
-
 	uint64_t elementCountOfPatch = subRep->getElementCountOfPatch(0);
 	std::unique_ptr<uint64_t[]> elementIndices(new uint64_t[elementCountOfPatch]);
 	subRep->getElementIndicesOfPatch(0, 0, elementIndices.get());
@@ -102,32 +100,97 @@ void ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::loadVtkObject()
 	_jCellCount = supportingGrid->getJCellCount();
 	_kCellCount = supportingGrid->getKCellCount();
 
-	size_t indice = 0;
+	const uint64_t iCellCount = _iCellCount;
+	const uint64_t ijCellCount = iCellCount * _jCellCount;
+	const uint64_t gridCellCount = ijCellCount * _kCellCount;
+	uint64_t const *const cellIndices = elementIndices.get();
+	if (std::any_of(cellIndices, cellIndices + elementCountOfPatch, [gridCellCount](uint64_t cellIndex)
+					{ return cellIndex >= gridCellCount; }))
+	{
+		supportingGrid->unloadSplitInformation();
+		vtkOutputWindowDisplayWarningText(("SubRepresentation (" + subRep->getUuid() + ") has element indices out of its supporting grid\n").c_str());
+		return;
+	}
 
-	for (uint_fast32_t vtkKCellIndex = 0; vtkKCellIndex < _kCellCount; ++vtkKCellIndex)
+	// The corner tables are read from fesapi in sequence : the K interface node index of the 4 top corners of each column of the listed cells
+	// (split coordinate lines taken into account) and the top K interface of each K layer (K gaps taken into account).
+	std::vector<uint64_t> columns(elementCountOfPatch);
+	std::transform(cellIndices, cellIndices + elementCountOfPatch, columns.begin(), [ijCellCount](uint64_t cellIndex)
+				   { return cellIndex % ijCellCount; });
+	std::sort(columns.begin(), columns.end());
+	columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+	const uint64_t kInterfaceNodeCount = supportingGrid->getXyzPointCountOfKInterface();
+	std::vector<uint64_t> columnCornerNodeIndices(columns.size() * 4);
+	for (size_t columnPosition = 0; columnPosition < columns.size(); ++columnPosition)
 	{
-		for (uint_fast32_t vtkJCellIndex = 0; vtkJCellIndex < _jCellCount; ++vtkJCellIndex)
+		const uint32_t iCellIndex = columns[columnPosition] % iCellCount;
+		const uint32_t jCellIndex = columns[columnPosition] / iCellCount;
+		for (uint_fast8_t cornerId = 0; cornerId < 4; ++cornerId)
 		{
-			for (uint_fast32_t vtkICellIndex = 0; vtkICellIndex < _iCellCount; ++vtkICellIndex)
-			{
-				if (elementIndices[indice] == cellIndex)
-				{
-					vtkSmartPointer<vtkHexahedron> hex = vtkSmartPointer<vtkHexahedron>::New();
-
-					for (uint_fast8_t cornerId = 0; cornerId < 8; ++cornerId)
-					{
-						hex->GetPointIds()->SetId(cornerId,
-							supportingGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, correspondingResqmlCornerId[cornerId]));
-					}
-					vtk_unstructuredGrid->InsertNextCell(hex->GetCellType(), hex->GetPointIds());
-					indice++;
-				}
-				++cellIndex;
-			}
+			columnCornerNodeIndices[columnPosition * 4 + cornerId] = supportingGrid->getXyzPointIndexFromCellCorner(iCellIndex, jCellIndex, 0, cornerId);
 		}
 	}
-
 	supportingGrid->unloadSplitInformation();
+
+	std::vector<uint64_t> kLayerTopKInterface(_kCellCount);
+	std::unique_ptr<bool[]> gapAfterLayer;
+	if (supportingGrid->getKGapsCount() > 0)
+	{
+		gapAfterLayer.reset(new bool[_kCellCount - 1]); // gap after each layer except for the last k cell
+		supportingGrid->getKGaps(gapAfterLayer.get());
+	}
+	uint64_t kInterface = 0;
+	for (uint32_t kLayer = 0; kLayer < _kCellCount; ++kLayer)
+	{
+		kLayerTopKInterface[kLayer] = kInterface++;
+		if (gapAfterLayer && kLayer < _kCellCount - 1 && gapAfterLayer[kLayer])
+		{
+			++kInterface;
+		}
+	}
+
+	// Create and set the list of hexahedra of the vtkUnstructuredGrid, the point ids being the RESQML node indices
+	// Only the listed cells are visited : each one copies its 8 corners from the tables at its own place
+	vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+	connectivity->SetNumberOfValues(elementCountOfPatch * 8);
+	vtkIdType *const cellPoints = connectivity->GetPointer(0);
+	vtkSMPTools::For(0, elementCountOfPatch, [cellIndices, cellPoints, ijCellCount, kInterfaceNodeCount, &columns, &columnCornerNodeIndices, &kLayerTopKInterface, &correspondingResqmlCornerId](vtkIdType cellBegin, vtkIdType cellEnd)
+					 {
+						 for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
+						 {
+							 const uint64_t *columnCorners = columnCornerNodeIndices.data() + (std::lower_bound(columns.begin(), columns.end(), cellIndices[cellId] % ijCellCount) - columns.begin()) * 4;
+							 const uint64_t topOffset = kLayerTopKInterface[cellIndices[cellId] / ijCellCount] * kInterfaceNodeCount;
+							 for (uint_fast8_t cornerId = 0; cornerId < 8; ++cornerId)
+							 {
+								 const unsigned int resqmlCornerId = correspondingResqmlCornerId[cornerId];
+								 cellPoints[cellId * 8 + cornerId] = (resqmlCornerId < 4 ? topOffset : topOffset + kInterfaceNodeCount) + columnCorners[resqmlCornerId % 4];
+							 }
+						 }
+					 });
+	vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+	cells->SetData(8, connectivity);
+	vtk_unstructuredGrid->SetCells(VTK_HEXAHEDRON, cells);
+
+	// Create and set the list of points of the vtkUnstructuredGrid
+	if (this->mapperIjkGrid->_maxProc > 1)
+	{
+		// The points of a partitioned supporting grid are only the nodes of its own cells : the subrepresentation reads the nodes of its cells
+		this->mapperIjkGrid->registerSubRep();
+		setReferencedPoints(cells);
+		compactPointIds(cells);
+		vtk_unstructuredGrid->SetPoints(this->mapperIjkGrid->createPointsOfNodes(_vtkPointToResqmlPoint));
+		addOriginalPointIds(vtk_unstructuredGrid);
+	}
+	else
+	{
+		vtk_unstructuredGrid->SetPoints(this->getMapperVtkPoint());
+		if (_compactPoints)
+		{
+			keepReferencedPointsOnly(vtk_unstructuredGrid, vtk_unstructuredGrid->GetPoints());
+		}
+	}
+	addGeometryOriginToFieldData(vtk_unstructuredGrid);
 	_vtkData->SetPartition(0, vtk_unstructuredGrid);
 	_vtkData->Modified();
 }
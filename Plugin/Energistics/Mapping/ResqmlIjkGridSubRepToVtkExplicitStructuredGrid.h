@@ -41,7 +41,7 @@ public:
 	/**
 	 * Constructor
 	 */
-	ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(const RESQML2_NS::SubRepresentation *ijkGridSubRep, ResqmlIjkGridToVtkExplicitStructuredGrid *support, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1);
+	ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(const RESQML2_NS::SubRepresentation *ijkGridSubRep, ResqmlIjkGridToVtkExplicitStructuredGrid *support, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1, bool p_compactPoints = false);
 
 	/**
 	 * load vtkDataSet with resqml data
@@ -58,6 +58,9 @@ protected:
 
 	ResqmlIjkGridToVtkExplicitStructuredGrid *mapperIjkGrid;
 
+	// Only keep the points of the supporting grid which are referenced by the cells
+	bool _compactPoints;
+
 private:
 	vtkSmartPointer<vtkPoints> getMapperVtkPoint();
 };
@@ -18,16 +18,21 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "Mapping/ResqmlIjkGridToVtkExplicitStructuredGrid.h"
 
+#include <algorithm>
 #include <array>
+#include <limits>
 
 // include VTK library
 #include <vtkSmartPointer.h>
+#include <vtkCellArray.h>
 #include <vtkCellData.h>
 #include <vtkDataArray.h>
 #include <vtkDoubleArray.h>
-#include <vtkEmptyCell.h>
-#include <vtkHexahedron.h>
+#include <vtkIdTypeArray.h>
 #include <vtkExplicitStructuredGrid.h>
+#include <vtkFieldData.h>
+#include <vtkSMPTools.h>
+#include <vtkUnsignedCharArray.h>
 #include "vtkPointData.h"
 
 // include FESAPI
@@ -38,12 +43,19 @@ under the License.
 #include "ResqmlPropertyToVtkDataArray.h"
 
 //----------------------------------------------------------------------------
-ResqmlIjkGridToVtkExplicitStructuredGrid::ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber, uint32_t p_maxProc)
+ResqmlIjkGridToVtkExplicitStructuredGrid::ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber, uint32_t p_maxProc, IjkPartitioning p_partitioning, bool p_ghostCellLayer)
 	: ResqmlAbstractRepresentationToVtkPartitionedDataSet(ijkGrid,
 														  p_procNumber,
 														  p_maxProc),
 	  points(vtkSmartPointer<vtkPoints>::New()),
-	  pointer_on_points(0)
+	  pointer_on_points(0),
+	  _columnCornerNodeIndices(),
+	  _kLayerTopKInterface(),
+	  _kInterfaceNodeCount(0),
+	  _blockNodeIndices(),
+	  _ownedExtent(),
+	  _activeCellCountPerProcess(),
+	  _cellGeometryIsDefinedFlags()
 {
 	_iCellCount = ijkGrid->getICellCount();
 	_jCellCount = ijkGrid->getJCellCount();
@@ -51,29 +63,256 @@ ResqmlIjkGridToVtkExplicitStructuredGrid::ResqmlIjkGridToVtkExplicitStructuredGr
 	_pointCount = ijkGrid->getXyzPointCountOfAllPatches();
 	checkHyperslabingCapacity(ijkGrid);
 
-	if (_isHyperslabed)
+	_initIIndex = 0;
+	_maxIIndex = _iCellCount;
+	_initJIndex = 0;
+	_maxJIndex = _jCellCount;
+	if (_isHyperslabed && p_partitioning == IjkPartitioning::Blocks && _maxProc > 1)
+	{
+		computeBlockPartition();
+	}
+	else if (_isHyperslabed && p_partitioning == IjkPartitioning::BalancedK && _maxProc > 1)
+	{
+		computeBalancedKPartition();
+	}
+	else if (_isHyperslabed)
 	{
-		const auto optim = (_kCellCount % p_maxProc) > 0 ? (_kCellCount / p_maxProc) + 1 : _kCellCount / p_maxProc;
-		_initKIndex = _procNumber * optim;
-		if (_initKIndex >= _kCellCount)
+		computeEqualKPartition();
+	}
+	else
+	{
+		_initKIndex = 0;
+		_maxKIndex = _kCellCount;
+	}
+
+	_ownedExtent = {_initIIndex, _maxIIndex, _initJIndex, _maxJIndex, _initKIndex, _maxKIndex};
+	if (p_ghostCellLayer && _isHyperslabed && _maxProc > 1 && _maxKIndex > _initKIndex)
+	{
+		addGhostCellLayer();
+	}
+
+	_vtkData = vtkSmartPointer<vtkPartitionedDataSet>::New();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::addGhostCellLayer()
+{
+	// The neighbour blocks are only where the block does not reach the grid boundary.
+	if (_initIIndex > 0)
+	{
+		--_initIIndex;
+	}
+	if (_maxIIndex < _iCellCount)
+	{
+		++_maxIIndex;
+	}
+	if (_initJIndex > 0)
+	{
+		--_initJIndex;
+	}
+	if (_maxJIndex < _jCellCount)
+	{
+		++_maxJIndex;
+	}
+	if (_initKIndex > 0)
+	{
+		--_initKIndex;
+	}
+	if (_maxKIndex < _kCellCount)
+	{
+		++_maxKIndex;
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::computeEqualKPartition()
+{
+	const auto optim = (_kCellCount % _maxProc) > 0 ? (_kCellCount / _maxProc) + 1 : _kCellCount / _maxProc;
+	_initKIndex = _procNumber * optim;
+	if (_initKIndex >= _kCellCount)
+	{
+		_initKIndex = 0;
+		_maxKIndex = 0;
+	}
+	else
+	{
+		_maxKIndex = _procNumber == _maxProc - 1
+						 ? _kCellCount
+						 : _initKIndex + optim;
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::computeBalancedKPartition()
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	const uint64_t kLayerCellCount = static_cast<uint64_t>(_iCellCount) * _jCellCount;
+
+	// Cumulative count of active cells before each K layer
+	std::vector<uint64_t> cumulativeActiveCellCount(_kCellCount + 1, 0);
+	if (ijkGrid->hasCellGeometryIsDefinedFlags())
+	{
+		const bool *enabledCells = getCellGeometryIsDefinedFlags();
+		for (uint32_t kLayer = 0; kLayer < _kCellCount; ++kLayer)
 		{
-			_initKIndex = 0;
-			_maxKIndex = 0;
+			const bool *kLayerEnabledCells = enabledCells + kLayer * kLayerCellCount;
+			cumulativeActiveCellCount[kLayer + 1] = cumulativeActiveCellCount[kLayer] + std::count(kLayerEnabledCells, kLayerEnabledCells + kLayerCellCount, true);
 		}
-		else
+	}
+	else
+	{
+		for (uint32_t kLayer = 0; kLayer < _kCellCount; ++kLayer)
 		{
-			_maxKIndex = _procNumber == _maxProc - 1
-								  ? _kCellCount
-								  : _initKIndex + optim;
+			cumulativeActiveCellCount[kLayer + 1] = cumulativeActiveCellCount[kLayer] + kLayerCellCount;
 		}
 	}
-	else
+
+	const uint64_t activeCellCount = cumulativeActiveCellCount[_kCellCount];
+	if (activeCellCount == 0)
+	{
+		computeEqualKPartition();
+		return;
+	}
+
+	// The cut before the process p is the K layer which best approaches p * activeCellCount / _maxProc active cells above it.
+	std::vector<uint32_t> kCuts(_maxProc + 1, _kCellCount);
+	kCuts[0] = 0;
+	for (uint32_t process = 1; process < _maxProc; ++process)
+	{
+		const uint64_t target = (activeCellCount * process) / _maxProc;
+		uint32_t kCut = static_cast<uint32_t>(std::lower_bound(cumulativeActiveCellCount.begin(), cumulativeActiveCellCount.end(), target) - cumulativeActiveCellCount.begin());
+		if (kCut > 0 && target - cumulativeActiveCellCount[kCut - 1] < cumulativeActiveCellCount[kCut] - target)
+		{
+			--kCut;
+		}
+		kCuts[process] = (std::max)(kCut, kCuts[process - 1]);
+	}
+
+	_activeCellCountPerProcess.resize(_maxProc);
+	for (uint32_t process = 0; process < _maxProc; ++process)
+	{
+		_activeCellCountPerProcess[process] = cumulativeActiveCellCount[kCuts[process + 1]] - cumulativeActiveCellCount[kCuts[process]];
+	}
+
+	_initKIndex = kCuts[_procNumber];
+	_maxKIndex = kCuts[_procNumber + 1];
+	if (_initKIndex == _maxKIndex)
 	{
+		// nothing to load for this process
 		_initKIndex = 0;
-		_maxKIndex = _kCellCount;
+		_maxKIndex = 0;
 	}
+}
 
-	_vtkData = vtkSmartPointer<vtkPartitionedDataSet>::New();
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::computeBlockPartition()
+{
+	// Look for the count of blocks along I, J and K which minimizes the area of the cuts.
+	// On equality, the most K blocks win since a K block is read in a single hyperslab.
+	// If the processes cannot all get a block (for instance a prime count of processes greater than each grid dimension), the last processes get nothing.
+	const uint64_t iCellCount = _iCellCount;
+	const uint64_t jCellCount = _jCellCount;
+	const uint64_t kCellCount = _kCellCount;
+	uint32_t iBlockCount = 0;
+	uint32_t jBlockCount = 0;
+	uint32_t kBlockCount = 0;
+	for (uint32_t blockCount = _maxProc; blockCount > 0 && kBlockCount == 0; --blockCount)
+	{
+		uint64_t minCutArea = (std::numeric_limits<uint64_t>::max)();
+		for (uint32_t kSplit = (std::min)(blockCount, _kCellCount); kSplit > 0; --kSplit)
+		{
+			if (blockCount % kSplit != 0)
+			{
+				continue;
+			}
+			const uint32_t ijBlockCount = blockCount / kSplit;
+			for (uint32_t jSplit = 1; jSplit <= ijBlockCount && jSplit <= _jCellCount; ++jSplit)
+			{
+				const uint32_t iSplit = ijBlockCount / jSplit;
+				if (ijBlockCount % jSplit != 0 || iSplit > _iCellCount)
+				{
+					continue;
+				}
+				const uint64_t cutArea = (iSplit - 1) * jCellCount * kCellCount +
+										 (jSplit - 1) * iCellCount * kCellCount +
+										 (kSplit - 1) * iCellCount * jCellCount;
+				if (cutArea < minCutArea)
+				{
+					minCutArea = cutArea;
+					iBlockCount = iSplit;
+					jBlockCount = jSplit;
+					kBlockCount = kSplit;
+				}
+			}
+		}
+	}
+
+	if (kBlockCount == 0 || _procNumber >= iBlockCount * jBlockCount * kBlockCount)
+	{
+		// nothing to load for this process
+		_initKIndex = 0;
+		_maxKIndex = 0;
+		return;
+	}
+
+	// I fastest, then J, then K as the RESQML cells
+	const uint64_t iBlock = _procNumber % iBlockCount;
+	const uint64_t jBlock = (_procNumber / iBlockCount) % jBlockCount;
+	const uint64_t kBlock = _procNumber / (iBlockCount * jBlockCount);
+	_initIIndex = static_cast<uint32_t>(iBlock * iCellCount / iBlockCount);
+	_maxIIndex = static_cast<uint32_t>((iBlock + 1) * iCellCount / iBlockCount);
+	_initJIndex = static_cast<uint32_t>(jBlock * jCellCount / jBlockCount);
+	_maxJIndex = static_cast<uint32_t>((jBlock + 1) * jCellCount / jBlockCount);
+	_initKIndex = static_cast<uint32_t>(kBlock * kCellCount / kBlockCount);
+	_maxKIndex = static_cast<uint32_t>((kBlock + 1) * kCellCount / kBlockCount);
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::addPartitionBalanceToFieldData(vtkDataObject *p_dataObject) const
+{
+	if (_activeCellCountPerProcess.empty())
+	{
+		return;
+	}
+
+	vtkSmartPointer<vtkIdTypeArray> activeCellCountPerProcess = vtkSmartPointer<vtkIdTypeArray>::New();
+	activeCellCountPerProcess->SetName("ActiveCellCountPerProcess");
+	activeCellCountPerProcess->SetNumberOfValues(_activeCellCountPerProcess.size());
+	uint64_t maxActiveCellCount = 0;
+	uint64_t activeCellCount = 0;
+	for (size_t process = 0; process < _activeCellCountPerProcess.size(); ++process)
+	{
+		activeCellCountPerProcess->SetValue(process, _activeCellCountPerProcess[process]);
+		maxActiveCellCount = (std::max)(maxActiveCellCount, _activeCellCountPerProcess[process]);
+		activeCellCount += _activeCellCountPerProcess[process];
+	}
+	p_dataObject->GetFieldData()->AddArray(activeCellCountPerProcess);
+
+	// max / mean : 1 is a perfect balance
+	vtkSmartPointer<vtkDoubleArray> imbalance = vtkSmartPointer<vtkDoubleArray>::New();
+	imbalance->SetName("PartitionImbalance");
+	imbalance->InsertNextValue(activeCellCount == 0 ? 1. : static_cast<double>(maxActiveCellCount) * _activeCellCountPerProcess.size() / activeCellCount);
+	p_dataObject->GetFieldData()->AddArray(imbalance);
+}
+
+//----------------------------------------------------------------------------
+const bool *ResqmlIjkGridToVtkExplicitStructuredGrid::getCellGeometryIsDefinedFlags()
+{
+	if (!_cellGeometryIsDefinedFlags)
+	{
+		const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+		const uint64_t cellCount = ijkGrid->getCellCount();
+		_cellGeometryIsDefinedFlags.reset(new bool[cellCount]);
+		if (ijkGrid->hasCellGeometryIsDefinedFlags())
+		{
+			ijkGrid->getCellGeometryIsDefinedFlags(_cellGeometryIsDefinedFlags.get());
+		}
+		else
+		{
+			std::fill_n(_cellGeometryIsDefinedFlags.get(), cellCount, true);
+		}
+	}
+	return _cellGeometryIsDefinedFlags.get();
 }
 
 //----------------------------------------------------------------------------
@@ -85,13 +324,15 @@ const RESQML2_NS::AbstractIjkGridRepresentation *ResqmlIjkGridToVtkExplicitStruc
 //----------------------------------------------------------------------------
 void ResqmlIjkGridToVtkExplicitStructuredGrid::checkHyperslabingCapacity(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid)
 {
+	// Only the explicit and parametric geometries store their points K interface by K interface.
+	// A compressed geometry cannot be read by hyperslab.
 	try
 	{
-		const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
-		const auto kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
-		std::unique_ptr<double[]> allXyzPoints(new double[kInterfaceNodeCount * 3]);
-		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(0, allXyzPoints.get());
-		_isHyperslabed = true;
+		const auto geometryKind = ijkGrid->getGeometryKind();
+		_isHyperslabed = !ijkGrid->isPartial() &&
+						 (geometryKind == RESQML2_NS::AbstractIjkGridRepresentation::geometryKind::EXPLICIT ||
+						  geometryKind == RESQML2_NS::AbstractIjkGridRepresentation::geometryKind::PARAMETRIC) &&
+						 !ijkGrid->isNodeGeometryCompressed();
 	}
 	catch (const std::exception &)
 	{
@@ -102,69 +343,255 @@ void ResqmlIjkGridToVtkExplicitStructuredGrid::checkHyperslabingCapacity(const R
 //----------------------------------------------------------------------------
 void ResqmlIjkGridToVtkExplicitStructuredGrid::loadVtkObject()
 {
-	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
-
 	vtkExplicitStructuredGrid *vtk_explicitStructuredGrid = vtkExplicitStructuredGrid::New();
 
-	int extent[6] = {0, _iCellCount, 0, _jCellCount, _initKIndex, _maxKIndex};
+	// The corner tables give the nodes of the block to read
+	loadCellCornerTables();
+
+	// The points first : they also give the RESQML nodes of the block
+	vtkSmartPointer<vtkPoints> vtkPts = getVtkPoints();
+
+	int extent[6] = {static_cast<int>(_initIIndex), static_cast<int>(_maxIIndex), static_cast<int>(_initJIndex), static_cast<int>(_maxJIndex), static_cast<int>(_initKIndex), static_cast<int>(_maxKIndex)};
 	vtk_explicitStructuredGrid->SetExtent(extent);
 
-	vtk_explicitStructuredGrid->SetPoints(getVtkPoints());
+	vtk_explicitStructuredGrid->SetPoints(vtkPts);
 
 	// Check which cells have no geometry
-	const uint64_t cellCount = ijkGrid->getCellCount();
-	std::unique_ptr<bool[]> enabledCells(new bool[cellCount]);
-	if (ijkGrid->hasCellGeometryIsDefinedFlags())
+	const bool *enabledCells = getCellGeometryIsDefinedFlags();
+
+	// Fill the VTK connectivity array in place, the K layers being shared among the SMP threads
+	const uint64_t iBlockCellCount = _maxIIndex - _initIIndex;
+	const uint64_t kLayerCellCount = iBlockCellCount * (_maxJIndex - _initJIndex);
+	const uint64_t localCellCount = kLayerCellCount * (_maxKIndex - _initKIndex);
+	vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+	connectivity->SetNumberOfValues(localCellCount * 8);
+	vtkIdType *const cellPoints = connectivity->GetPointer(0);
+	vtkSMPTools::For(_initKIndex, _maxKIndex, [this, cellPoints, kLayerCellCount](vtkIdType kBegin, vtkIdType kEnd)
+					 {
+						 for (vtkIdType vtkKCellIndex = kBegin; vtkKCellIndex < kEnd; ++vtkKCellIndex)
+						 {
+							 fillKLayerCellPoints(vtkKCellIndex, cellPoints + (vtkKCellIndex - _initKIndex) * kLayerCellCount * 8);
+						 }
+					 });
+	vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+	cells->SetData(8, connectivity);
+	vtk_explicitStructuredGrid->SetCells(cells);
+
+	// The VTK cell order is the RESQML one restricted to the block : each row of I cells of the block is contiguous in the RESQML cells.
+	const uint64_t iCellCount = _iCellCount;
+	const uint64_t gridKLayerCellCount = iCellCount * _jCellCount;
+	const bool *enabledBlockCells = enabledCells + gridKLayerCellCount * _initKIndex + iCellCount * _initJIndex + _initIIndex;
+	const uint64_t jBlockCellCount = _maxJIndex - _initJIndex;
+	const uint64_t rowCount = jBlockCellCount * (_maxKIndex - _initKIndex);
+	auto rowCells = [enabledBlockCells, iCellCount, gridKLayerCellCount, jBlockCellCount](uint64_t rowIndex)
+	{
+		return enabledBlockCells + (rowIndex / jBlockCellCount) * gridKLayerCellCount + (rowIndex % jBlockCellCount) * iCellCount;
+	};
+	bool hasDisabledCell = false;
+	for (uint64_t rowIndex = 0; rowIndex < rowCount && !hasDisabledCell; ++rowIndex)
 	{
-		ijkGrid->getCellGeometryIsDefinedFlags(enabledCells.get());
+		const bool *enabledRowCells = rowCells(rowIndex);
+		hasDisabledCell = std::find(enabledRowCells, enabledRowCells + iBlockCellCount, false) != enabledRowCells + iBlockCellCount;
 	}
-	else
+	// Owned extent relatively to the loaded block
+	const std::array<uint32_t, 6> ownedExtent = {_ownedExtent[0] - _initIIndex, _ownedExtent[1] - _initIIndex,
+												 _ownedExtent[2] - _initJIndex, _ownedExtent[3] - _initJIndex,
+												 _ownedExtent[4] - _initKIndex, _ownedExtent[5] - _initKIndex};
+	const bool hasGhostCells = ownedExtent[0] > 0 || ownedExtent[1] < iBlockCellCount ||
+							   ownedExtent[2] > 0 || ownedExtent[3] < jBlockCellCount ||
+							   ownedExtent[4] > 0 || ownedExtent[5] < _maxKIndex - _initKIndex;
+	if (hasDisabledCell || hasGhostCells)
 	{
-		std::fill_n(enabledCells.get(), cellCount, true);
+		// Same as vtkExplicitStructuredGrid::BlankCell but written in parallel in the cell ghost array
+		unsigned char *ghosts = vtk_explicitStructuredGrid->AllocateCellGhostArray()->GetPointer(0);
+		vtkSMPTools::For(0, rowCount, [rowCells, iBlockCellCount, jBlockCellCount, ownedExtent, ghosts](vtkIdType rowBegin, vtkIdType rowEnd)
+						 {
+							 for (vtkIdType rowIndex = rowBegin; rowIndex < rowEnd; ++rowIndex)
+							 {
+								 const uint64_t jIndex = rowIndex % jBlockCellCount;
+								 const uint64_t kIndex = rowIndex / jBlockCellCount;
+								 const bool isGhostRow = jIndex < ownedExtent[2] || jIndex >= ownedExtent[3] ||
+														 kIndex < ownedExtent[4] || kIndex >= ownedExtent[5];
+								 const bool *enabledRowCells = rowCells(rowIndex);
+								 unsigned char *rowGhosts = ghosts + rowIndex * iBlockCellCount;
+								 for (uint64_t iIndex = 0; iIndex < iBlockCellCount; ++iIndex)
+								 {
+									 if (!enabledRowCells[iIndex])
+									 {
+										 rowGhosts[iIndex] |= vtkDataSetAttributes::HIDDENCELL;
+									 }
+									 if (isGhostRow || iIndex < ownedExtent[0] || iIndex >= ownedExtent[1])
+									 {
+										 rowGhosts[iIndex] |= vtkDataSetAttributes::DUPLICATECELL;
+									 }
+								 }
+							 }
+						 });
 	}
 
-	const uint64_t translatePoint = ijkGrid->getXyzPointCountOfKInterface() * _initKIndex;
+	vtk_explicitStructuredGrid->CheckAndReorderFaces();
+	vtk_explicitStructuredGrid->ComputeFacesConnectivityFlagsArray();
+	addGeometryOriginToFieldData(vtk_explicitStructuredGrid);
+	addPartitionBalanceToFieldData(vtk_explicitStructuredGrid);
+
+	_vtkData->SetPartition(0, vtk_explicitStructuredGrid);
+	_vtkData->Modified();
+}
 
-	const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->loadSplitInformation();
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::loadCellCornerTables()
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
 
-	uint64_t cellIndex = 0;
-	vtkSmartPointer<vtkIdList> nodes = vtkSmartPointer<vtkIdList>::New();
-	nodes->SetNumberOfIds(8);
+	_kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
 
-	for (uint_fast32_t vtkKCellIndex = _initKIndex; vtkKCellIndex < _maxKIndex; ++vtkKCellIndex)
+	// Top K interface of each K layer
+	_kLayerTopKInterface.resize(_kCellCount);
+	std::unique_ptr<bool[]> gapAfterLayer;
+	if (ijkGrid->getKGapsCount() > 0)
 	{
-		for (uint_fast32_t vtkJCellIndex = 0; vtkJCellIndex < _jCellCount; ++vtkJCellIndex)
+		gapAfterLayer.reset(new bool[_kCellCount - 1]); // gap after each layer except for the last k cell
+		ijkGrid->getKGaps(gapAfterLayer.get());
+	}
+	uint32_t kInterface = 0;
+	for (uint32_t kLayer = 0; kLayer < _kCellCount; ++kLayer)
+	{
+		_kLayerTopKInterface[kLayer] = kInterface++;
+		if (gapAfterLayer && kLayer < _kCellCount - 1 && gapAfterLayer[kLayer])
 		{
-			for (uint_fast32_t vtkICellIndex = 0; vtkICellIndex < _iCellCount; ++vtkICellIndex)
+			++kInterface;
+		}
+	}
+
+	// Corners of the columns : needed if some columns lie on split coordinate lines or if the process only loads a block
+	_columnCornerNodeIndices.clear();
+	_blockNodeIndices.clear();
+	const bool wholeKInterfaces = _initIIndex == 0 && _maxIIndex == _iCellCount && _initJIndex == 0 && _maxJIndex == _jCellCount;
+	const uint64_t splitCoordinateLineCount = ijkGrid->getSplitCoordinateLineCount();
+	if (splitCoordinateLineCount == 0 && wholeKInterfaces)
+	{
+		return;
+	}
+
+	const uint64_t iPillarCount = _iCellCount + 1;
+	const uint64_t iBlockCellCount = _maxIIndex - _initIIndex;
+	_columnCornerNodeIndices.resize(iBlockCellCount * (_maxJIndex - _initJIndex) * 4);
+	uint64_t *columnCorners = _columnCornerNodeIndices.data();
+	for (uint64_t jColumn = _initJIndex; jColumn < _maxJIndex; ++jColumn)
+	{
+		for (uint64_t iColumn = _initIIndex; iColumn < _maxIIndex; ++iColumn)
+		{
+			const uint64_t pillarIndex = iColumn + jColumn * iPillarCount;
+			columnCorners[0] = pillarIndex;
+			columnCorners[1] = pillarIndex + 1;
+			columnCorners[2] = pillarIndex + iPillarCount + 1;
+			columnCorners[3] = pillarIndex + iPillarCount;
+			columnCorners += 4;
+		}
+	}
+
+	if (splitCoordinateLineCount > 0)
+	{
+		loadSplitColumnCorners(splitCoordinateLineCount);
+	}
+
+	if (!wholeKInterfaces)
+	{
+		// Only keep the K interface nodes of the block : the corners become indices in the kept nodes.
+		_blockNodeIndices = _columnCornerNodeIndices;
+		std::sort(_blockNodeIndices.begin(), _blockNodeIndices.end());
+		_blockNodeIndices.erase(std::unique(_blockNodeIndices.begin(), _blockNodeIndices.end()), _blockNodeIndices.end());
+		for (uint64_t &corner : _columnCornerNodeIndices)
+		{
+			corner = std::lower_bound(_blockNodeIndices.begin(), _blockNodeIndices.end(), corner) - _blockNodeIndices.begin();
+		}
+		_kInterfaceNodeCount = _blockNodeIndices.size();
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::loadSplitColumnCorners(uint64_t p_splitCoordinateLineCount)
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	const uint64_t iPillarCount = _iCellCount + 1;
+	const uint64_t pillarCount = iPillarCount * (_jCellCount + 1);
+	const uint64_t iBlockCellCount = _maxIIndex - _initIIndex;
+
+	std::unique_ptr<unsigned int[]> pillarOfSplitCoordinateLines(new unsigned int[p_splitCoordinateLineCount]);
+	ijkGrid->getPillarsOfSplitCoordinateLines(pillarOfSplitCoordinateLines.get());
+	std::unique_ptr<unsigned int[]> cumulativeColumnCountOfSplitCoordinateLines(new unsigned int[p_splitCoordinateLineCount]);
+	ijkGrid->getColumnCountOfSplitCoordinateLines(cumulativeColumnCountOfSplitCoordinateLines.get());
+	std::unique_ptr<unsigned int[]> columnsOfSplitCoordinateLines(new unsigned int[cumulativeColumnCountOfSplitCoordinateLines[p_splitCoordinateLineCount - 1]]);
+	ijkGrid->getColumnsOfSplitCoordinateLines(columnsOfSplitCoordinateLines.get());
+
+	uint64_t columnIndexPosition = 0;
+	for (uint64_t splitCoordinateLineIndex = 0; splitCoordinateLineIndex < p_splitCoordinateLineCount; ++splitCoordinateLineIndex)
+	{
+		const uint64_t iPillar = pillarOfSplitCoordinateLines[splitCoordinateLineIndex] % iPillarCount;
+		const uint64_t jPillar = pillarOfSplitCoordinateLines[splitCoordinateLineIndex] / iPillarCount;
+		for (; columnIndexPosition < cumulativeColumnCountOfSplitCoordinateLines[splitCoordinateLineIndex]; ++columnIndexPosition)
+		{
+			const uint64_t columnIndex = columnsOfSplitCoordinateLines[columnIndexPosition];
+			const uint64_t iColumn = columnIndex % _iCellCount;
+			const uint64_t jColumn = columnIndex / _iCellCount;
+			if (iColumn < _initIIndex || iColumn >= _maxIIndex || jColumn < _initJIndex || jColumn >= _maxJIndex)
 			{
-				vtkIdType cellId = vtk_explicitStructuredGrid->ComputeCellId(vtkICellIndex, vtkJCellIndex, vtkKCellIndex);
-				if (enabledCells[cellIndex++])
-				{
-					vtkIdType *indice = vtk_explicitStructuredGrid->GetCellPoints(cellId);
-					indice[0] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 0) - translatePoint;
-					indice[1] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 1) - translatePoint;
-					indice[2] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 2) - translatePoint;
-					indice[3] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 3) - translatePoint;
-					indice[4] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 4) - translatePoint;
-					indice[5] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 5) - translatePoint;
-					indice[6] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 6) - translatePoint;
-					indice[7] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 7) - translatePoint;
-				}
-				else
-				{
-					vtk_explicitStructuredGrid->BlankCell(cellId);
-				}
+				continue;
 			}
+			// corner 0 is (i, j), corner 1 is (i+1, j), corner 2 is (i+1, j+1) and corner 3 is (i, j+1)
+			const uint_fast8_t corner = jPillar == jColumn
+											? (iPillar == iColumn ? 0 : 1)
+											: (iPillar == iColumn ? 3 : 2);
+			_columnCornerNodeIndices[((jColumn - _initJIndex) * iBlockCellCount + iColumn - _initIIndex) * 4 + corner] = pillarCount + splitCoordinateLineIndex;
 		}
 	}
+}
 
-	const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->unloadSplitInformation();
-
-	vtk_explicitStructuredGrid->CheckAndReorderFaces();
-	vtk_explicitStructuredGrid->ComputeFacesConnectivityFlagsArray();
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::fillKLayerCellPoints(uint32_t p_kCellIndex, vtkIdType *p_cellPoints) const
+{
+	// The VTK points start at the top K interface of the first loaded K layer
+	const vtkIdType topOffset = static_cast<vtkIdType>(_kLayerTopKInterface[p_kCellIndex] - _kLayerTopKInterface[_initKIndex]) * _kInterfaceNodeCount;
+	const vtkIdType bottomOffset = topOffset + _kInterfaceNodeCount;
 
-	_vtkData->SetPartition(0, vtk_explicitStructuredGrid);
-	_vtkData->Modified();
+	if (_columnCornerNodeIndices.empty())
+	{
+		// No split coordinate line : the corners are the pillars of the column
+		const vtkIdType iPillarCount = _iCellCount + 1;
+		for (uint_fast32_t vtkJCellIndex = 0; vtkJCellIndex < _jCellCount; ++vtkJCellIndex)
+		{
+			const vtkIdType firstPillarOfRow = vtkJCellIndex * iPillarCount;
+			for (uint_fast32_t vtkICellIndex = 0; vtkICellIndex < _iCellCount; ++vtkICellIndex)
+			{
+				const vtkIdType pillarIndex = firstPillarOfRow + vtkICellIndex;
+				p_cellPoints[0] = topOffset + pillarIndex;
+				p_cellPoints[1] = topOffset + pillarIndex + 1;
+				p_cellPoints[2] = topOffset + pillarIndex + iPillarCount + 1;
+				p_cellPoints[3] = topOffset + pillarIndex + iPillarCount;
+				p_cellPoints[4] = bottomOffset + pillarIndex;
+				p_cellPoints[5] = bottomOffset + pillarIndex + 1;
+				p_cellPoints[6] = bottomOffset + pillarIndex + iPillarCount + 1;
+				p_cellPoints[7] = bottomOffset + pillarIndex + iPillarCount;
+				p_cellPoints += 8;
+			}
+		}
+	}
+	else
+	{
+		const uint64_t *columnCorners = _columnCornerNodeIndices.data();
+		const uint64_t *const columnCornersEnd = columnCorners + _columnCornerNodeIndices.size();
+		for (; columnCorners != columnCornersEnd; columnCorners += 4, p_cellPoints += 8)
+		{
+			p_cellPoints[0] = topOffset + columnCorners[0];
+			p_cellPoints[1] = topOffset + columnCorners[1];
+			p_cellPoints[2] = topOffset + columnCorners[2];
+			p_cellPoints[3] = topOffset + columnCorners[3];
+			p_cellPoints[4] = bottomOffset + columnCorners[0];
+			p_cellPoints[5] = bottomOffset + columnCorners[1];
+			p_cellPoints[6] = bottomOffset + columnCorners[2];
+			p_cellPoints[7] = bottomOffset + columnCorners[3];
+		}
+	}
 }
 
 //----------------------------------------------------------------------------
@@ -183,11 +610,16 @@ void ResqmlIjkGridToVtkExplicitStructuredGrid::createPoints()
 {
 	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
 
-	this->points->SetNumberOfPoints(_pointCount);
-	size_t point_id = 0;
+	double *allXyzPoints = nullptr; // Will be deleted by VTK
+	uint64_t pointCount = 0;
 
-	if (_isHyperslabed && !ijkGrid->isNodeGeometryCompressed())
+	if (_isHyperslabed)
 	{
+		if (_kLayerTopKInterface.empty())
+		{
+			loadCellCornerTables();
+		}
+
 		// Take into account K gaps
 		const uint32_t kGapCount = ijkGrid->getKGapsCount();
 		uint32_t initKInterfaceIndex = _initKIndex;
@@ -215,55 +647,226 @@ void ResqmlIjkGridToVtkExplicitStructuredGrid::createPoints()
 		}
 
 		const uint64_t kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
-		std::unique_ptr<double[]> allXyzPoints(new double[kInterfaceNodeCount * 3]);
+		pointCount = (_blockNodeIndices.empty() ? kInterfaceNodeCount : _blockNodeIndices.size()) * (maxKInterfaceIndex - initKInterfaceIndex + 1);
+		// The RESQML node of each VTK point when only a part of the grid is loaded, for the node properties
+		_vtkPointToResqmlPoint.clear();
+		if (pointCount != _pointCount)
+		{
+			_vtkPointToResqmlPoint.reserve(pointCount);
+			for (uint64_t kInterface = initKInterfaceIndex; kInterface <= maxKInterfaceIndex; ++kInterface)
+			{
+				const uint64_t firstNodeIndex = kInterface * kInterfaceNodeCount;
+				if (_blockNodeIndices.empty())
+				{
+					for (uint64_t nodeIndex = 0; nodeIndex < kInterfaceNodeCount; ++nodeIndex)
+					{
+						_vtkPointToResqmlPoint.push_back(firstNodeIndex + nodeIndex);
+					}
+				}
+				else
+				{
+					for (const uint64_t nodeIndex : _blockNodeIndices)
+					{
+						_vtkPointToResqmlPoint.push_back(firstNodeIndex + nodeIndex);
+					}
+				}
+			}
+		}
 
-		for (uint_fast32_t kInterface = initKInterfaceIndex; kInterface <= maxKInterfaceIndex; ++kInterface)
+		auto const *crs = ijkGrid->getLocalCrs(0);
+		if (crs == nullptr || crs->isPartial())
+		{
+			vtkOutputWindowDisplayWarningText("The CRS doesn't exist or is partial");
+		}
+		allXyzPoints = new double[pointCount * 3];
+		try
 		{
-			const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(kInterface, allXyzPoints.get());
-			auto const *crs = ijkGrid->getLocalCrs(0);
-			double xOffset = .0;
-			double yOffset = .0;
-			double zOffset = .0;
-			double zIndice = allXyzPoints[2] > 0 ? -1. : 1.;
-			if (crs != nullptr && !crs->isPartial())
+			if (_blockNodeIndices.empty())
 			{
-				xOffset = crs->getOriginOrdinal1();
-				yOffset = crs->getOriginOrdinal2();
-				auto const *depthCrs = dynamic_cast<RESQML2_NS::LocalDepth3dCrs const *>(crs);
-				zOffset = depthCrs != nullptr ? depthCrs->getOriginDepthOrElevation() : 0;
-				zIndice = crs->isDepthOriented() ? -1. : 1.;
+				// Read all the K interfaces of this process straight into the VTK buffer
+				const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterfaceSequence(initKInterfaceIndex, maxKInterfaceIndex, allXyzPoints);
 			}
 			else
 			{
-				vtkOutputWindowDisplayWarningText("The CRS doesn't exist or is partial");
+				// Only read the nodes of the block : for each K interface, its pillars then its split coordinate lines, in the order of _blockNodeIndices.
+				bool isBlockRead = false;
+				try
+				{
+					const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->loadBlockInformation(_initIIndex, _maxIIndex, _initJIndex, _maxJIndex, initKInterfaceIndex, maxKInterfaceIndex);
+					if (ijkGrid->getXyzPointCountOfBlock() == pointCount)
+					{
+						const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfBlock(allXyzPoints);
+						isBlockRead = true;
+					}
+				}
+				catch (const std::exception &)
+				{
+					// The geometry of this grid cannot be read by block : fall back to its whole K interfaces
+				}
+
+				if (!isBlockRead)
+				{
+					// Stream the K interfaces one by one, only keeping the nodes of the block
+					std::unique_ptr<double[]> kInterfaceXyzPoints(new double[kInterfaceNodeCount * 3]);
+					double *blockXyzPoints = allXyzPoints;
+					for (uint32_t kInterface = initKInterfaceIndex; kInterface <= maxKInterfaceIndex; ++kInterface)
+					{
+						const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(kInterface, kInterfaceXyzPoints.get());
+						for (const uint64_t nodeIndex : _blockNodeIndices)
+						{
+							blockXyzPoints = std::copy_n(kInterfaceXyzPoints.get() + nodeIndex * 3, 3, blockXyzPoints);
+						}
+					}
+				}
+			}
+			moveToGlobalCrs(allXyzPoints, pointCount);
+		}
+		catch (const std::exception &)
+		{
+			// The metadata allowed hyperslabing but the storage (for instance an ETP store) does not : extract the points of this process from all the points of the grid.
+			// The extent of this process is kept since the other processes load the rest of the grid, whether their own reads succeed or not.
+			std::unique_ptr<double[]> gridXyzPoints(readAllXyzPoints());
+			if (_vtkPointToResqmlPoint.empty())
+			{
+				delete[] allXyzPoints;
+				allXyzPoints = gridXyzPoints.release();
 			}
-			for (uint_fast64_t nodeIndex = 0; nodeIndex < kInterfaceNodeCount * 3; nodeIndex += 3)
+			else
 			{
-				this->points->SetPoint(point_id++, allXyzPoints[nodeIndex] + xOffset, allXyzPoints[nodeIndex + 1] + yOffset, (allXyzPoints[nodeIndex + 2] + zOffset) * zIndice);
+				double *xyzPoints = allXyzPoints;
+				for (const uint64_t nodeIndex : _vtkPointToResqmlPoint)
+				{
+					xyzPoints = std::copy_n(gridXyzPoints.get() + nodeIndex * 3, 3, xyzPoints);
+				}
 			}
 		}
 	}
 	else
 	{
+		_initIIndex = 0;
+		_maxIIndex = _iCellCount;
+		_initJIndex = 0;
+		_maxJIndex = _jCellCount;
 		_initKIndex = 0;
 		_maxKIndex = _kCellCount;
-
-		std::unique_ptr<double[]> allXyzPoints(new double[_pointCount * 3]);
-		auto const *crs = ijkGrid->getLocalCrs(0);
-		if (crs != nullptr && !crs->isPartial())
+		_ownedExtent = {_initIIndex, _maxIIndex, _initJIndex, _maxJIndex, _initKIndex, _maxKIndex};
+		if (!_blockNodeIndices.empty())
 		{
-			ijkGrid->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints.get());
-			const size_t coordCount = _pointCount * 3;
+			loadCellCornerTables();
+		}
+		_vtkPointToResqmlPoint.clear();
+
+		pointCount = _pointCount;
+		allXyzPoints = readAllXyzPoints();
+	}
 
-			const double zIndice = ijkGrid->getLocalCrs(0)->isDepthOriented() ? -1 : 1;
-			for (uint_fast64_t pointIndex = 0; pointIndex < coordCount; pointIndex += 3)
+	this->points = createVtkPoints(allXyzPoints, pointCount);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> ResqmlIjkGridToVtkExplicitStructuredGrid::createPointsOfNodes(const std::vector<uint64_t> &p_nodes)
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+
+	double *keptXyzPoints = new double[p_nodes.size() * 3]; // Will be deleted by VTK
+	bool isRead = false;
+	if (_isHyperslabed)
+	{
+		// Stream the K interfaces of the nodes one by one, only keeping the asked nodes
+		try
+		{
+			const uint64_t kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
+			std::unique_ptr<double[]> kInterfaceXyzPoints(new double[kInterfaceNodeCount * 3]);
+			double *xyzPoints = keptXyzPoints;
+			std::vector<uint64_t>::const_iterator node = p_nodes.begin();
+			while (node != p_nodes.end())
 			{
-				this->points->SetPoint(point_id++, allXyzPoints[pointIndex], allXyzPoints[pointIndex + 1], -allXyzPoints[pointIndex + 2] * zIndice);
+				const uint64_t kInterface = *node / kInterfaceNodeCount;
+				const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(kInterface, kInterfaceXyzPoints.get());
+				for (; node != p_nodes.end() && *node / kInterfaceNodeCount == kInterface; ++node)
+				{
+					xyzPoints = std::copy_n(kInterfaceXyzPoints.get() + (*node % kInterfaceNodeCount) * 3, 3, xyzPoints);
+				}
 			}
+			moveToGlobalCrs(keptXyzPoints, p_nodes.size());
+			isRead = true;
 		}
-		else
+		catch (const std::exception &)
 		{
-			vtkOutputWindowDisplayWarningText("The CRS doesn't exist or is partial");
+			// The storage does not read the points by hyperslab : fall back to all the points of the grid
+		}
+	}
+
+	if (!isRead)
+	{
+		std::unique_ptr<double[]> allXyzPoints(readAllXyzPoints());
+		double *xyzPoints = keptXyzPoints;
+		for (const uint64_t node : p_nodes)
+		{
+			xyzPoints = std::copy_n(allXyzPoints.get() + node * 3, 3, xyzPoints);
 		}
 	}
+
+	return createVtkPoints(keptXyzPoints, p_nodes.size());
+}
+
+//----------------------------------------------------------------------------
+double *ResqmlIjkGridToVtkExplicitStructuredGrid::readAllXyzPoints() const
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+
+	double *allXyzPoints = new double[_pointCount * 3];
+	auto const *crs = ijkGrid->getLocalCrs(0);
+	const bool partialCRS = crs == nullptr || crs->isPartial();
+	if (partialCRS)
+	{
+		vtkOutputWindowDisplayWarningText(("The local CRS of : " + ijkGrid->getUuid() + " doesn't exist or is partial. Get coordinates in local CRS instead.\n").c_str());
+		ijkGrid->getXyzPointsOfAllPatches(allXyzPoints);
+	}
+	else
+	{
+		ijkGrid->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints);
+	}
+
+	if (!partialCRS && crs->isDepthOriented())
+	{
+		vtkSMPTools::For(0, _pointCount, [allXyzPoints](vtkIdType pointBegin, vtkIdType pointEnd)
+						 {
+							 for (vtkIdType zCoordIndex = pointBegin * 3 + 2; zCoordIndex < pointEnd * 3; zCoordIndex += 3)
+							 {
+								 allXyzPoints[zCoordIndex] *= -1;
+							 }
+						 });
+	}
+	return allXyzPoints;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::moveToGlobalCrs(double *p_xyzPoints, uint64_t p_pointCount) const
+{
+	auto const *crs = getResqmlData()->getLocalCrs(0);
+	double xOffset = .0;
+	double yOffset = .0;
+	double zOffset = .0;
+	double zIndice = p_xyzPoints[2] > 0 ? -1. : 1.;
+	if (crs != nullptr && !crs->isPartial())
+	{
+		xOffset = crs->getOriginOrdinal1();
+		yOffset = crs->getOriginOrdinal2();
+		auto const *depthCrs = dynamic_cast<RESQML2_NS::LocalDepth3dCrs const *>(crs);
+		zOffset = depthCrs != nullptr ? depthCrs->getOriginDepthOrElevation() : 0;
+		zIndice = crs->isDepthOriented() ? -1. : 1.;
+	}
+
+	vtkSMPTools::For(0, p_pointCount, [p_xyzPoints, xOffset, yOffset, zOffset, zIndice](vtkIdType pointBegin, vtkIdType pointEnd)
+					 {
+						 double *xyzPoints = p_xyzPoints + pointBegin * 3;
+						 double *const xyzPointsEnd = p_xyzPoints + pointEnd * 3;
+						 for (; xyzPoints != xyzPointsEnd; xyzPoints += 3)
+						 {
+							 xyzPoints[0] += xOffset;
+							 xyzPoints[1] += yOffset;
+							 xyzPoints[2] = (xyzPoints[2] + zOffset) * zIndice;
+						 }
+					 });
 }
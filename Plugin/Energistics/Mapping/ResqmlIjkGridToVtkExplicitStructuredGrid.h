@@ -23,7 +23,10 @@ under the License.
  */
 
 // include system
+#include <array>
+#include <memory>
 #include <string>
+#include <vector>
 
 // include VTK
 #include <vtkSmartPointer.h>
@@ -35,6 +38,7 @@ namespace RESQML2_NS
 {
 	class AbstractIjkGridRepresentation;
 }
+class ResqmlIjkGridSubRepToVtkExplicitStructuredGrid;
 
 class ResqmlIjkGridToVtkExplicitStructuredGrid : public ResqmlAbstractRepresentationToVtkPartitionedDataSet
 {
@@ -42,7 +46,7 @@ public:
 	/**
 	 * Constructor
 	 */
-	explicit ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1);
+	explicit ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1, IjkPartitioning p_partitioning = IjkPartitioning::EqualK, bool p_ghostCellLayer = false);
 
 	/**
 	 * load vtkDataSet with resqml data
@@ -59,6 +63,13 @@ public:
 	 */
 	vtkSmartPointer<vtkPoints> getVtkPoints();
 
+	/**
+	 * Create the VTK points of some nodes of the grid, for instance the ones of a subrepresentation.
+	 *
+	 * @param p_nodes	The sorted RESQML index of each node, not empty.
+	 */
+	vtkSmartPointer<vtkPoints> createPointsOfNodes(const std::vector<uint64_t> &p_nodes);
+
 protected:
 	const RESQML2_NS::AbstractIjkGridRepresentation *getResqmlData() const;
 	vtkSmartPointer<vtkPoints> points;
@@ -68,8 +79,99 @@ protected:
 	/**
 	 * method : checkHyperslabingCapacity
 	 * variable : ijkGridRepresentation
-	 * check if an ijkgrid is Hyperslabed
+	 * check if an ijkgrid is Hyperslabed, from its geometry metadata only (no data is read).
+	 * The result lasts as long as the mapper : it is reset if the storage fails to read the points by hyperslab.
 	 */
 	void checkHyperslabingCapacity(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid);
+
+	/**
+	 * Give the same count of K layers to each process.
+	 */
+	void computeEqualKPartition();
+
+	/**
+	 * Cut the K layers so that each process gets about the same count of cells with a defined geometry.
+	 * The count of active cells of each process is kept in _activeCellCountPerProcess.
+	 */
+	void computeBalancedKPartition();
+
+	/**
+	 * Cut the grid in I, J and K blocks, one per process.
+	 * The count of blocks along each direction only depends on the grid dimensions and on the count of processes
+	 * so that all the processes, and the properties read later on, agree on the same decomposition.
+	 */
+	void computeBlockPartition();
+
+	/**
+	 * Record the count of active cells of each process and the resulting imbalance in the field data of the VTK grid.
+	 * Does nothing if the partition has not been balanced.
+	 */
+	void addPartitionBalanceToFieldData(vtkDataObject *p_dataObject) const;
+
+	/**
+	 * Read the flags of the cells with a defined geometry at the first call, all the cells being defined if the grid has no flag.
+	 * Both the balanced partition and the loading of the grid use them.
+	 */
+	const bool *getCellGeometryIsDefinedFlags();
+
+	/**
+	 * Extend the block of the process by one cell towards each neighbour block.
+	 * The cells of the extension are flagged as duplicate cells in the VTK ghost array.
+	 */
+	void addGhostCellLayer();
+
+	/**
+	 * Load, once for all K layers, the K interface local node index of the 4 pillar corners of each column
+	 * (split coordinate lines taken into account) and the top K interface of each K layer (K gaps taken into account).
+	 * The column corner table remains empty when the grid has no split coordinate line: corner indices are then pure arithmetic.
+	 * When the process only loads an I, J block, the tables are restricted to the block columns and the corners are indices in _blockNodeIndices.
+	 */
+	void loadCellCornerTables();
+
+	/**
+	 * Set the corners of the columns of the process which lie on split coordinate lines.
+	 *
+	 * @param p_splitCoordinateLineCount	The count of split coordinate lines of the grid, greater than 0.
+	 */
+	void loadSplitColumnCorners(uint64_t p_splitCoordinateLineCount);
+
+	/**
+	 * Fill the 8 VTK point indices of all cells of a K layer, in the VTK cell order (I fastest, then J).
+	 *
+	 * @param p_kCellIndex		The K index of the layer to fill.
+	 * @param p_cellPoints		The first point index of the first cell of the layer in the VTK connectivity array.
+	 */
+	void fillKLayerCellPoints(uint32_t p_kCellIndex, vtkIdType *p_cellPoints) const;
+
+	/**
+	 * Read all the points of the grid in its global CRS, the Z axis pointing upwards.
+	 *
+	 * @return	A new buffer of _pointCount * 3 coordinates, owned by the caller.
+	 */
+	double *readAllXyzPoints() const;
+
+	/**
+	 * Move in place some points read in the local CRS of the grid to its global CRS, the Z axis pointing upwards.
+	 */
+	void moveToGlobalCrs(double *p_xyzPoints, uint64_t p_pointCount) const;
+
+	// K interface local node index of the corners 0, 1, 2, 3 of each column. Empty if the grid has no split coordinate line.
+	std::vector<uint64_t> _columnCornerNodeIndices;
+	// Top K interface index of each K layer
+	std::vector<uint32_t> _kLayerTopKInterface;
+	uint64_t _kInterfaceNodeCount;
+	// K interface node indices kept by the process. Empty if the process loads whole K interfaces.
+	std::vector<uint64_t> _blockNodeIndices;
+
+	// init I, max I, init J, max J, init K, max K of the cells owned by the process. The other loaded cells are ghost cells.
+	std::array<uint32_t, 6> _ownedExtent;
+
+	// Count of cells with a defined geometry of each process. Empty if the partition has not been balanced.
+	std::vector<uint64_t> _activeCellCountPerProcess;
+
+	// Geometry defined flag of each RESQML cell, read once. Empty until getCellGeometryIsDefinedFlags is called.
+	std::unique_ptr<bool[]> _cellGeometryIsDefinedFlags;
+
+	friend class ResqmlIjkGridSubRepToVtkExplicitStructuredGrid;
 };
 #endif
@@ -64,8 +64,6 @@ void ResqmlPolylineToVtkPolyData::loadVtkObject()
 	double *allXyzPoints = new double[_pointCount * 3]; // Will be deleted by VTK
 	polyline->getXyzPointsOfPatchInGlobalCrs(0, allXyzPoints);
 
-	vtkSmartPointer<vtkPoints> vtkPts = vtkSmartPointer<vtkPoints>::New();
-
 	const size_t coordCount = _pointCount * 3;
 	if (polyline->getLocalCrs(0)->isDepthOriented())
 	{
@@ -75,11 +73,7 @@ void ResqmlPolylineToVtkPolyData::loadVtkObject()
 		}
 	}
 
-	vtkSmartPointer<vtkDoubleArray> vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
-	vtkUnderlyingArray->SetNumberOfComponents(3);
-	// Take ownership of the underlying C array
-	vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-	vtkPts->SetData(vtkUnderlyingArray);
+	vtkSmartPointer<vtkPoints> vtkPts = createVtkPoints(allXyzPoints, _pointCount);
 	vtk_polydata->SetPoints(vtkPts);
 
 	// POLYLINE
@@ -103,6 +97,8 @@ void ResqmlPolylineToVtkPolyData::loadVtkObject()
 		vtk_polydata->SetLines(setPolylineRepresentationLines);
 	}
 
+	addGeometryOriginToFieldData(vtk_polydata);
+
 	_vtkData->SetPartition(0, vtk_polydata);
 	_vtkData->Modified();
 }
@@ -19,123 +19,795 @@ under the License.
 #include "Mapping/ResqmlPropertyToVtkDataArray.h"
 #include "vtkMath.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <type_traits>
+
 // FESAPI
+#include <fesapi/eml2/AbstractHdfProxy.h>
 #include <fesapi/resqml2/CategoricalProperty.h>
 #include <fesapi/resqml2/ContinuousProperty.h>
 #include <fesapi/resqml2/DiscreteProperty.h>
 
 // VTK
+#include <vtkArrayDispatch.h>
+#include <vtkDataArrayRange.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkDoubleArray.h>
 #include <vtkFloatArray.h>
 #include <vtkLongArray.h>
 #include <vtkUnsignedLongArray.h>
+#include <vtkLongLongArray.h>
+#include <vtkUnsignedLongLongArray.h>
 #include <vtkIntArray.h>
 #include <vtkUnsignedIntArray.h>
 #include <vtkShortArray.h>
 #include <vtkUnsignedShortArray.h>
-#include <vtkCharArray.h>
+#include <vtkSignedCharArray.h>
 #include <vtkUnsignedCharArray.h>
 
-//----------------------------------------------------------------------------
-ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(const RESQML2_NS::AbstractValuesProperty *valuesProperty,
-														   uint64_t cellCount,
-														   uint64_t pointCount,
-														   uint32_t iCellCount,
-														   uint32_t jCellCount,
-														   uint32_t kCellCount,
-														   uint32_t initKIndex,
-														   uint64_t patch_index)
+#include "Mapping/ResqmlDeferredDataArray.h"
+
+namespace
 {
-	uint32_t nbElement = 0;
+	typedef COMMON_NS::AbstractObject::numericalDatatypeEnum Datatype;
 
-	const gsoap_eml2_3::eml23__IndexableElement element = valuesProperty->getAttachmentKind();
-	if (element == gsoap_eml2_3::eml23__IndexableElement::cells ||
-		element == gsoap_eml2_3::eml23__IndexableElement::triangles)
+	// The VTK arrays of the 64 bits integers, whose C++ type depends on the platform
+	typedef std::conditional<std::is_same<int64_t, long>::value, vtkLongArray, vtkLongLongArray>::type Int64Array;
+	typedef std::conditional<std::is_same<uint64_t, unsigned long>::value, vtkUnsignedLongArray, vtkUnsignedLongLongArray>::type UInt64Array;
+
+	struct BlockExtent
 	{
-		nbElement = cellCount;
+		uint64_t iCellCount;
+		uint64_t jCellCount;
+		uint64_t iBlockCellCount;
+		uint64_t jBlockCellCount;
+		uint64_t kBlockCellCount;
+		uint64_t initIIndex;
+		uint64_t initJIndex;
+		uint64_t componentCount; // the values of each cell are interleaved
+	};
+
+	/**
+	 * Get the datatype of the VTK array of a property : its HDF5 datatype if it suits the kind of property,
+	 * else double for a continuous property and int32 for the others.
+	 */
+	Datatype getArrayDatatype(const RESQML2_NS::AbstractValuesProperty *valuesProperty, bool continuous)
+	{
+		const Datatype datatype = valuesProperty->getValuesHdfDatatype();
+		switch (datatype)
+		{
+		case Datatype::DOUBLE:
+		case Datatype::FLOAT:
+			return continuous ? datatype : Datatype::INT32;
+		case Datatype::INT64:
+		case Datatype::UINT64:
+		case Datatype::INT32:
+		case Datatype::UINT32:
+		case Datatype::INT16:
+		case Datatype::UINT16:
+		case Datatype::INT8:
+		case Datatype::UINT8:
+			return continuous ? Datatype::DOUBLE : datatype;
+		default:
+			return continuous ? Datatype::DOUBLE : Datatype::INT32;
+		}
 	}
-	else if (element == gsoap_eml2_3::eml23__IndexableElement::nodes)
+
+	/**
+	 * Get the count of elements along the first dimension of the chunks of the dataset of a patch, 1 if the dataset is not chunked or if its storage does not tell.
+	 */
+	uint64_t getChunkElementCountOfPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex)
 	{
-		nbElement = pointCount;
+		try
+		{
+			int64_t nullValue = 0;
+			std::string datasetPath;
+			EML2_NS::AbstractHdfProxy *hdfProxy = valuesProperty->getDatasetOfPatch(patchIndex, nullValue, datasetPath);
+			const std::vector<uint32_t> chunkDimensions = hdfProxy->getElementCountPerChunkDimension(datasetPath);
+			if (!chunkDimensions.empty() && chunkDimensions[0] > 0)
+			{
+				return chunkDimensions[0];
+			}
+		}
+		catch (const std::exception &)
+		{
+			// The slabs are then not aligned on the chunks
+		}
+		return 1;
 	}
-	else
+
+	uint64_t greatestCommonDivisor(uint64_t first, uint64_t second)
 	{
-		throw std::invalid_argument("Property indexable element must be points or cells.");
+		while (second != 0)
+		{
+			const uint64_t remainder = first % second;
+			first = second;
+			second = remainder;
+		}
+		return first;
 	}
 
-	const uint32_t elementCountPerValue = valuesProperty->getElementCountPerValue();
-	if (elementCountPerValue != 1)
+	/**
+	 * Read a hyperslab of a patch, 1d by default, in float or in int32 through fesapi,
+	 * or in double or in int64 through the HDF proxy of the patch since fesapi does not read them partially (HDF5 converting the other 64 bits and the uint32 values to int64).
+	 */
+	void readValuesOfPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, double *values, uint64_t const *numValuesInEachDimension, uint64_t const *offsetInEachDimension, unsigned int numArrayDimensions = 1)
 	{
-		vtkOutputWindowDisplayErrorText("does not support vectorial property yet\n");
+		int64_t nullValue = 0;
+		std::string datasetPath;
+		EML2_NS::AbstractHdfProxy *hdfProxy = valuesProperty->getDatasetOfPatch(patchIndex, nullValue, datasetPath);
+		hdfProxy->readArrayNdOfDoubleValues(datasetPath, values, numValuesInEachDimension, offsetInEachDimension, numArrayDimensions);
 	}
 
-	const uint64_t numValuesInEachDimension = cellCount;						 // cellCount/kCellCount; //3834;//iCellCount*jCellCount*kCellCount;
-	const uint64_t offsetInEachDimension = iCellCount * jCellCount * initKIndex; // initKIndex;//iCellCount*jCellCount*initKIndex;
+	void readValuesOfPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, int64_t *values, uint64_t const *numValuesInEachDimension, uint64_t const *offsetInEachDimension, unsigned int numArrayDimensions = 1)
+	{
+		int64_t nullValue = 0;
+		std::string datasetPath;
+		EML2_NS::AbstractHdfProxy *hdfProxy = valuesProperty->getDatasetOfPatch(patchIndex, nullValue, datasetPath);
+		hdfProxy->readArrayNdOfInt64Values(datasetPath, values, numValuesInEachDimension, offsetInEachDimension, numArrayDimensions);
+	}
+
+	void readValuesOfPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, float *values, uint64_t const *numValuesInEachDimension, uint64_t const *offsetInEachDimension, unsigned int numArrayDimensions = 1)
+	{
+		valuesProperty->getFloatValuesOfPatch(patchIndex, values, numValuesInEachDimension, offsetInEachDimension, numArrayDimensions);
+	}
+
+	void readValuesOfPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, int32_t *values, uint64_t const *numValuesInEachDimension, uint64_t const *offsetInEachDimension, unsigned int numArrayDimensions = 1)
+	{
+		valuesProperty->getIntValuesOfPatch(patchIndex, values, numValuesInEachDimension, offsetInEachDimension, numArrayDimensions);
+	}
+
+	/**
+	 * Read the values of an I, J, K block of a 3d patch, in float or in int32 through fesapi, else in double or in int64 by a 3d hyperslab.
+	 */
+	template <typename T>
+	void readValuesOf3dPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, T *values, const BlockExtent &block, uint64_t initKIndex)
+	{
+		const uint64_t numValuesInEachDimension[3] = {block.kBlockCellCount, block.jBlockCellCount, block.iBlockCellCount};
+		const uint64_t offsetInEachDimension[3] = {initKIndex, block.initJIndex, block.initIIndex};
+		readValuesOfPatch(valuesProperty, patchIndex, values, numValuesInEachDimension, offsetInEachDimension, 3);
+	}
+
+	void readValuesOf3dPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, float *values, const BlockExtent &block, uint64_t initKIndex)
+	{
+		valuesProperty->getFloatValuesOf3dPatch(patchIndex, values, block.iBlockCellCount, block.jBlockCellCount, block.kBlockCellCount, block.initIIndex, block.initJIndex, initKIndex);
+	}
+
+	void readValuesOf3dPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, int32_t *values, const BlockExtent &block, uint64_t initKIndex)
+	{
+		valuesProperty->getIntValuesOf3dPatch(patchIndex, values, block.iBlockCellCount, block.jBlockCellCount, block.kBlockCellCount, block.initIIndex, block.initJIndex, initKIndex);
+	}
 
-	std::string typeProperty = valuesProperty->getXmlTag();
-	if (typeProperty == RESQML2_NS::ContinuousProperty::XML_TAG)
+	/**
+	 * Get the buffer to read some values of type T for an array of type U : the array itself if they have the same type, else a new temporary buffer.
+	 */
+	template <typename T>
+	T *readBufferOf(T *values, std::unique_ptr<T[]> &, uint64_t)
 	{
-		vtkSmartPointer<vtkFloatArray> cellDataFloat = vtkSmartPointer<vtkFloatArray>::New();
-		float *valuesFloatSet = new float[nbElement]; // deleted by VTK cellData vtkSmartPointer
-		if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 3)
+		return values;
+	}
+
+	template <typename T, typename U>
+	T *readBufferOf(U *, std::unique_ptr<T[]> &buffer, uint64_t valueCount)
+	{
+		buffer.reset(new T[valueCount]);
+		return buffer.get();
+	}
+
+	/**
+	 * Wrap some values in a new VTK array, which takes their ownership.
+	 */
+	template <typename VtkArray>
+	vtkSmartPointer<vtkDataArray> newDataArray(typename VtkArray::ValueType *values, uint64_t valueCount, uint32_t componentCount, const std::string &name)
+	{
+		vtkSmartPointer<VtkArray> dataArray = vtkSmartPointer<VtkArray>::New();
+		dataArray->SetNumberOfComponents(componentCount);
+		dataArray->SetName(name.c_str());
+		dataArray->SetArray(values, valueCount, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
+		return dataArray;
+	}
+
+	/**
+	 * Read all the values of a patch in a VTK array of the given datatype.
+	 */
+	vtkSmartPointer<vtkDataArray> readPatch(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, Datatype datatype, uint64_t valueCount, uint32_t componentCount, const std::string &name)
+	{
+		switch (datatype)
+		{
+		case Datatype::DOUBLE:
 		{
-			valuesProperty->getFloatValuesOf3dPatch(patch_index, valuesFloatSet, iCellCount, jCellCount, kCellCount, 0, 0, initKIndex);
+			double *values = new double[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getDoubleValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkDoubleArray>(values, valueCount, componentCount, name);
 		}
-		else if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 1)
+		case Datatype::FLOAT:
 		{
-			valuesProperty->getFloatValuesOfPatch(patch_index, valuesFloatSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
+			float *values = new float[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getFloatValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkFloatArray>(values, valueCount, componentCount, name);
 		}
-		else
+		case Datatype::INT64:
+		{
+			int64_t *values = new int64_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getInt64ValuesOfPatch(patchIndex, values);
+			return newDataArray<Int64Array>(values, valueCount, componentCount, name);
+		}
+		case Datatype::UINT64:
+		{
+			uint64_t *values = new uint64_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getUInt64ValuesOfPatch(patchIndex, values);
+			return newDataArray<UInt64Array>(values, valueCount, componentCount, name);
+		}
+		case Datatype::UINT32:
 		{
-			vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
+			uint32_t *values = new uint32_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getUInt32ValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkUnsignedIntArray>(values, valueCount, componentCount, name);
+		}
+		case Datatype::INT16:
+		{
+			int16_t *values = new int16_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getInt16ValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkShortArray>(values, valueCount, componentCount, name);
+		}
+		case Datatype::UINT16:
+		{
+			uint16_t *values = new uint16_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getUInt16ValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkUnsignedShortArray>(values, valueCount, componentCount, name);
+		}
+		case Datatype::INT8:
+		{
+			int8_t *values = new int8_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getInt8ValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkSignedCharArray>(values, valueCount, componentCount, name);
+		}
+		case Datatype::UINT8:
+		{
+			uint8_t *values = new uint8_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getUInt8ValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkUnsignedCharArray>(values, valueCount, componentCount, name);
+		}
+		default:
+		{
+			int32_t *values = new int32_t[valueCount]; // deleted by VTK data vtkSmartPointer
+			valuesProperty->getInt32ValuesOfPatch(patchIndex, values);
+			return newDataArray<vtkIntArray>(values, valueCount, componentCount, name);
+		}
 		}
-		cellDataFloat->SetName(valuesProperty->getTitle().c_str());
-		cellDataFloat->SetArray(valuesFloatSet, nbElement, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataFloat;
 	}
-	else if (typeProperty == RESQML2_NS::DiscreteProperty::XML_TAG)
+
+	/**
+	 * The minimum and maximum of each component of some tuples and, if there are several components, of their L2 norm.
+	 * The NaN values are ignored.
+	 */
+	class TupleRanges
 	{
-		vtkSmartPointer<vtkIntArray> cellDataInt = vtkSmartPointer<vtkIntArray>::New();
-		int32_t *valuesIntSet = new int32_t[nbElement]; // deleted by VTK cellData vtkSmartPointer
-		if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 3)
+	public:
+		explicit TupleRanges(int p_componentCount) : componentCount(p_componentCount), ranges(2 * (p_componentCount > 1 ? p_componentCount + 1 : 1))
 		{
-			valuesProperty->getIntValuesOf3dPatch(patch_index, valuesIntSet, iCellCount, jCellCount, kCellCount, 0, 0, initKIndex);
+			for (size_t rangeIndex = 0; rangeIndex < this->ranges.size(); rangeIndex += 2)
+			{
+				this->ranges[rangeIndex] = std::numeric_limits<double>::max();
+				this->ranges[rangeIndex + 1] = std::numeric_limits<double>::lowest();
+			}
 		}
-		else if (valuesProperty->getDimensionsCountOfPatch(0) == 1)
+
+		/**
+		 * @param tuple	The components of a tuple, accessed by operator[].
+		 */
+		template <typename Tuple>
+		void add(const Tuple &tuple)
 		{
-			valuesProperty->getIntValuesOfPatch(patch_index, valuesIntSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
+			double squaredNorm = 0;
+			for (int componentIndex = 0; componentIndex < this->componentCount; ++componentIndex)
+			{
+				const double value = static_cast<double>(tuple[componentIndex]);
+				if (!std::isnan(value))
+				{
+					this->ranges[2 * componentIndex] = std::min(this->ranges[2 * componentIndex], value);
+					this->ranges[2 * componentIndex + 1] = std::max(this->ranges[2 * componentIndex + 1], value);
+				}
+				squaredNorm += value * value;
+			}
+			if (this->componentCount > 1 && !std::isnan(squaredNorm))
+			{
+				const double norm = std::sqrt(squaredNorm);
+				this->ranges[2 * this->componentCount] = std::min(this->ranges[2 * this->componentCount], norm);
+				this->ranges[2 * this->componentCount + 1] = std::max(this->ranges[2 * this->componentCount + 1], norm);
+			}
 		}
-		else
+
+		void merge(const TupleRanges &other)
+		{
+			for (size_t rangeIndex = 0; rangeIndex < this->ranges.size(); rangeIndex += 2)
+			{
+				this->ranges[rangeIndex] = std::min(this->ranges[rangeIndex], other.ranges[rangeIndex]);
+				this->ranges[rangeIndex + 1] = std::max(this->ranges[rangeIndex + 1], other.ranges[rangeIndex + 1]);
+			}
+		}
+
+		const std::vector<double> &get() const { return this->ranges; }
+
+	private:
+		int componentCount;
+		std::vector<double> ranges;
+	};
+
+	/**
+	 * Copy the values of an I, J block from the values of whole K layers, adding the copied tuples to their ranges.
+	 */
+	template <typename T, typename U>
+	void extractBlock(const T *kLayersValues, U *blockValues, const BlockExtent &block, TupleRanges &ranges)
+	{
+		for (uint64_t kIndex = 0; kIndex < block.kBlockCellCount; ++kIndex)
+		{
+			for (uint64_t jIndex = 0; jIndex < block.jBlockCellCount; ++jIndex)
+			{
+				const T *rowValues = kLayersValues + ((kIndex * block.jCellCount + block.initJIndex + jIndex) * block.iCellCount + block.initIIndex) * block.componentCount;
+				U *rowBlockValues = blockValues;
+				blockValues = std::copy(rowValues, rowValues + block.iBlockCellCount * block.componentCount, blockValues);
+				for (; rowBlockValues != blockValues; rowBlockValues += block.componentCount)
+				{
+					ranges.add(rowBlockValues);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Get the minimum and maximum of each component of a property from its XML statistics, or nothing if one of them is missing.
+	 */
+	std::vector<double> getStatistics(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint32_t componentCount)
+	{
+		std::vector<double> ranges;
+		if (valuesProperty->getXmlTag() == RESQML2_NS::ContinuousProperty::XML_TAG)
+		{
+			RESQML2_NS::ContinuousProperty const *continuousProperty = static_cast<RESQML2_NS::ContinuousProperty const *>(valuesProperty);
+			for (uint32_t componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+			{
+				const double minimum = continuousProperty->getMinimumValue(componentIndex);
+				const double maximum = continuousProperty->getMaximumValue(componentIndex);
+				if (std::isnan(minimum) || std::isnan(maximum))
+				{
+					return std::vector<double>();
+				}
+				ranges.push_back(minimum);
+				ranges.push_back(maximum);
+			}
+		}
+		else if (valuesProperty->getXmlTag() == RESQML2_NS::DiscreteProperty::XML_TAG)
 		{
-			vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
+			RESQML2_NS::DiscreteProperty const *discreteProperty = static_cast<RESQML2_NS::DiscreteProperty const *>(valuesProperty);
+			for (uint32_t componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+			{
+				if (!discreteProperty->hasMinimumValue(componentIndex) || !discreteProperty->hasMaximumValue(componentIndex))
+				{
+					return std::vector<double>();
+				}
+				ranges.push_back(discreteProperty->getMinimumValue(componentIndex));
+				ranges.push_back(discreteProperty->getMaximumValue(componentIndex));
+			}
 		}
-		cellDataInt->SetName(valuesProperty->getTitle().c_str());
-		cellDataInt->SetArray(valuesIntSet, nbElement, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataInt;
+		return ranges;
 	}
-	else if (typeProperty == RESQML2_NS::CategoricalProperty::XML_TAG)
+
+	/**
+	 * Compute in a single pass the ranges of the tuples of an array whose values have not been copied by the partial reads.
+	 */
+	template <typename ArrayT>
+	class RangeFunctor
 	{
-		vtkSmartPointer<vtkIntArray> cellDataInt = vtkSmartPointer<vtkIntArray>::New();
-		int32_t*valuesIntSet = new int32_t[nbElement]; // deleted by VTK cellData vtkSmartPointer
-		if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 3)
+	public:
+		explicit RangeFunctor(ArrayT *p_array) : array(p_array), componentCount(p_array->GetNumberOfComponents()), threadRanges(TupleRanges(p_array->GetNumberOfComponents())) {}
+
+		void operator()(vtkIdType tupleBegin, vtkIdType tupleEnd)
 		{
-			valuesProperty->getIntValuesOf3dPatch(patch_index, valuesIntSet, iCellCount, jCellCount, kCellCount, 0, 0, initKIndex);
+			TupleRanges &localRanges = this->threadRanges.Local();
+			for (const auto tuple : vtk::DataArrayTupleRange(this->array, tupleBegin, tupleEnd))
+			{
+				localRanges.add(tuple);
+			}
 		}
-		else if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 1)
+
+		void Reduce()
+		{
+			TupleRanges reducedRanges(this->componentCount);
+			for (const TupleRanges &localRanges : this->threadRanges)
+			{
+				reducedRanges.merge(localRanges);
+			}
+			this->ranges = reducedRanges.get();
+		}
+
+		std::vector<double> ranges;
+
+	private:
+		ArrayT *array;
+		const int componentCount;
+		vtkSMPThreadLocal<TupleRanges> threadRanges;
+	};
+
+	struct RangeWorker
+	{
+		template <typename ArrayT>
+		void operator()(ArrayT *array)
+		{
+			RangeFunctor<ArrayT> functor(array);
+			vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+			this->ranges = functor.ranges;
+		}
+
+		std::vector<double> ranges;
+	};
+
+	/**
+	 * Store the ranges of an array in its information, where vtkDataArray::GetRange looks for them first.
+	 */
+	void storeRanges(vtkDataArray *dataArray, const std::vector<double> &ranges)
+	{
+		const int componentCount = dataArray->GetNumberOfComponents();
+		vtkSmartPointer<vtkInformationVector> componentInfos = vtkSmartPointer<vtkInformationVector>::New();
+		for (int componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+		{
+			vtkSmartPointer<vtkInformation> componentInfo = vtkSmartPointer<vtkInformation>::New();
+			componentInfo->Set(vtkDataArray::COMPONENT_RANGE(), ranges.data() + 2 * componentIndex, 2);
+			if (std::isfinite(ranges[2 * componentIndex]) && std::isfinite(ranges[2 * componentIndex + 1]))
+			{
+				componentInfo->Set(vtkDataArray::COMPONENT_FINITE_RANGE(), ranges.data() + 2 * componentIndex, 2);
+			}
+			componentInfos->SetInformationObject(componentIndex, componentInfo);
+		}
+		vtkInformation *info = dataArray->GetInformation();
+		info->Set(vtkDataArray::PER_COMPONENT(), componentInfos);
+		if (ranges.size() > 2 * static_cast<size_t>(componentCount))
+		{
+			info->Set(vtkDataArray::L2_NORM_RANGE(), ranges.data() + 2 * componentCount, 2);
+			if (std::isfinite(ranges[2 * componentCount + 1]))
+			{
+				info->Set(vtkDataArray::L2_NORM_FINITE_RANGE(), ranges.data() + 2 * componentCount, 2);
+			}
+		}
+	}
+
+	/**
+	 * Get the ranges stored in the information of an array by storeRanges, or nothing if some are missing.
+	 */
+	std::vector<double> getStoredRanges(vtkDataArray *dataArray)
+	{
+		if (!dataArray->HasInformation() || !dataArray->GetInformation()->Has(vtkDataArray::PER_COMPONENT()))
+		{
+			return std::vector<double>();
+		}
+		vtkInformation *info = dataArray->GetInformation();
+		vtkInformationVector *componentInfos = info->Get(vtkDataArray::PER_COMPONENT());
+		const int componentCount = dataArray->GetNumberOfComponents();
+		if (componentInfos->GetNumberOfInformationObjects() < componentCount)
+		{
+			return std::vector<double>();
+		}
+		std::vector<double> ranges;
+		for (int componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+		{
+			vtkInformation *componentInfo = componentInfos->GetInformationObject(componentIndex);
+			if (componentInfo == nullptr || !componentInfo->Has(vtkDataArray::COMPONENT_RANGE()))
+			{
+				return std::vector<double>();
+			}
+			const double *range = componentInfo->Get(vtkDataArray::COMPONENT_RANGE());
+			ranges.push_back(range[0]);
+			ranges.push_back(range[1]);
+		}
+		if (componentCount > 1)
+		{
+			if (!info->Has(vtkDataArray::L2_NORM_RANGE()))
+			{
+				return std::vector<double>();
+			}
+			const double *range = info->Get(vtkDataArray::L2_NORM_RANGE());
+			ranges.push_back(range[0]);
+			ranges.push_back(range[1]);
+		}
+		return ranges;
+	}
+
+	/**
+	 * Create a deferred data array of T values, whose loading holds the read mutex since it happens outside of the reader requests.
+	 */
+	template <typename T>
+	vtkSmartPointer<vtkDataArray> newDeferredDataArray(uint64_t tupleCount, uint32_t componentCount, const std::function<vtkSmartPointer<vtkDataArray>()> &loader, const std::vector<double> &ranges)
+	{
+		vtkSmartPointer<ResqmlDeferredDataArray<T>> dataArray = vtkSmartPointer<ResqmlDeferredDataArray<T>>::New();
+		dataArray->SetLoader(tupleCount, componentCount, [loader]() -> vtkSmartPointer<vtkDataArray>
+							 {
+								 std::lock_guard<std::recursive_mutex> lock(ResqmlPropertyToVtkDataArray::getReadMutex());
+								 return loader(); },
+							 ranges);
+		return dataArray;
+	}
+
+	/**
+	 * Read the values of an I, J block by slabs of whole K layers, the temporary slab of T values not exceeding maxBufferSize bytes (but at least one K layer).
+	 * The size of a slab is a multiple of the size of the chunks of the patch when they are smaller, so that a chunk is not read by two slabs more than necessary.
+	 *
+	 * @param chunkValueCount	The count of values of a chunk of the 1d patch.
+	 * @param ranges			Receives the ranges of the tuples of the block, computed while they are copied.
+	 * @param readValues		Reads some values of the 1d patch : (values, numValuesInEachDimension, offsetInEachDimension)
+	 */
+	template <typename T, typename U, typename ReadValues>
+	void readBlockBySlabs(U *blockValues, const BlockExtent &block, uint64_t initKIndex, uint64_t chunkValueCount, uint64_t maxBufferSize, TupleRanges &ranges, ReadValues readValues)
+	{
+		const uint64_t kLayerValueCount = block.iCellCount * block.jCellCount * block.componentCount;
+		uint64_t slabKLayerCount = std::max<uint64_t>(1, std::min<uint64_t>(block.kBlockCellCount, maxBufferSize / (kLayerValueCount * sizeof(T))));
+		// The least count of K layers whose values are a multiple of the chunk size
+		const uint64_t chunkKLayerCount = chunkValueCount / greatestCommonDivisor(chunkValueCount, kLayerValueCount);
+		if (slabKLayerCount > chunkKLayerCount && slabKLayerCount < block.kBlockCellCount)
 		{
-			valuesProperty->getIntValuesOfPatch(patch_index, valuesIntSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
+			slabKLayerCount -= slabKLayerCount % chunkKLayerCount;
+		}
+		std::unique_ptr<T[]> slabValues(new T[slabKLayerCount * kLayerValueCount]);
+		for (uint64_t kSlabIndex = 0; kSlabIndex < block.kBlockCellCount; kSlabIndex += slabKLayerCount)
+		{
+			BlockExtent slab = block;
+			slab.kBlockCellCount = std::min(slabKLayerCount, block.kBlockCellCount - kSlabIndex);
+			const uint64_t numValuesInEachDimension = slab.kBlockCellCount * kLayerValueCount;
+			const uint64_t offsetInEachDimension = (initKIndex + kSlabIndex) * kLayerValueCount;
+			readValues(slabValues.get(), &numValuesInEachDimension, &offsetInEachDimension);
+			extractBlock(slabValues.get(), blockValues + kSlabIndex * block.iBlockCellCount * block.jBlockCellCount * block.componentCount, slab, ranges);
+		}
+	}
+
+	/**
+	 * Read the values of an I, J, K block of an IJK grid in a new VtkArray, fesapi reading them partially as T values.
+	 * The ranges of the values are stored in the array when they are copied from a temporary buffer, else they are left to getRanges.
+	 */
+	template <typename VtkArray, typename T>
+	vtkSmartPointer<vtkDataArray> readBlock(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, const BlockExtent &block, uint64_t initKIndex, uint64_t maxBufferSize, const std::string &name)
+	{
+		typedef typename VtkArray::ValueType ValueType;
+		const unsigned int dimensionCount = valuesProperty->getDimensionsCountOfPatch(patchIndex);
+		if (dimensionCount != 1 && dimensionCount != 4 && (dimensionCount != 3 || block.componentCount != 1))
+		{
+			throw std::invalid_argument("The values of the property " + valuesProperty->getUuid() + " cannot be read by block : its patch has " + std::to_string(dimensionCount) + " dimensions (1, 3 or 4 with components are supported).");
+		}
+
+		const uint64_t valueCount = block.iBlockCellCount * block.jBlockCellCount * block.kBlockCellCount * block.componentCount;
+		ValueType *values = new ValueType[valueCount]; // deleted by VTK data vtkSmartPointer
+		std::unique_ptr<T[]> readValues;
+		TupleRanges ranges(block.componentCount);
+		bool copied = false;
+		if (dimensionCount == 3)
+		{
+			readValuesOf3dPatch(valuesProperty, patchIndex, readBufferOf(values, readValues, valueCount), block, initKIndex);
+		}
+		else if (dimensionCount == 4)
+		{
+			// K, J, I and the components, which are all read
+			const uint64_t numValuesInEachDimension[4] = {block.kBlockCellCount, block.jBlockCellCount, block.iBlockCellCount, block.componentCount};
+			const uint64_t offsetInEachDimension[4] = {initKIndex, block.initJIndex, block.initIIndex, 0};
+			readValuesOfPatch(valuesProperty, patchIndex, readBufferOf(values, readValues, valueCount), numValuesInEachDimension, offsetInEachDimension, 4);
 		}
 		else
 		{
-			vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
+			// Whole K layers are read straight into the array, else the I and J block is extracted from bounded slabs of K layers.
+			if (block.iBlockCellCount == block.iCellCount && block.jBlockCellCount == block.jCellCount && std::is_same<ValueType, T>::value)
+			{
+				const uint64_t offsetInEachDimension = block.iCellCount * block.jCellCount * initKIndex * block.componentCount;
+				readValuesOfPatch(valuesProperty, patchIndex, readBufferOf(values, readValues, valueCount), &valueCount, &offsetInEachDimension);
+			}
+			else
+			{
+				readBlockBySlabs<T>(values, block, initKIndex, getChunkElementCountOfPatch(valuesProperty, patchIndex), maxBufferSize, ranges, [valuesProperty, patchIndex](T *slabValues, uint64_t const *numValues, uint64_t const *offsets)
+									{ readValuesOfPatch(valuesProperty, patchIndex, slabValues, numValues, offsets); });
+				copied = true;
+			}
+		}
+		if (readValues)
+		{
+			for (uint64_t valueIndex = 0; valueIndex < valueCount; valueIndex += block.componentCount)
+			{
+				std::copy(readValues.get() + valueIndex, readValues.get() + valueIndex + block.componentCount, values + valueIndex);
+				ranges.add(values + valueIndex);
+			}
+			copied = true;
+		}
+		vtkSmartPointer<vtkDataArray> dataArray = newDataArray<VtkArray>(values, valueCount, block.componentCount, name);
+		if (copied && valueCount > 0)
+		{
+			storeRanges(dataArray, ranges.get());
 		}
-		cellDataInt->SetName(valuesProperty->getTitle().c_str());
-		cellDataInt->SetArray(valuesIntSet, nbElement, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataInt;
+		return dataArray;
+	}
+
+	/**
+	 * Read the values of some tuples of a 1d patch by slabs, the temporary slab of T values not exceeding maxBufferSize bytes (but at least one tuple).
+	 * A slab starts at the chunk of the first kept tuple not read yet and ends at the last kept tuple at most, so that the parts of the patch without kept tuples are skipped.
+	 * The size of a slab is a multiple of the size of the chunks of the patch when they are smaller.
+	 *
+	 * @param keptValues		Receives the values of the kept tuples, in the order of keptTuples.
+	 * @param chunkTupleCount	The count of tuples of a chunk of the patch.
+	 * @param ranges			Receives the ranges of the kept tuples, computed while they are copied.
+	 * @param readValues		Reads some values of the 1d patch : (values, numValuesInEachDimension, offsetInEachDimension)
+	 */
+	template <typename T, typename U, typename ReadValues>
+	void readTuplesBySlabs(U *keptValues, const std::vector<uint64_t> &keptTuples, uint64_t tupleCount, uint32_t componentCount, uint64_t chunkTupleCount, uint64_t maxBufferSize, TupleRanges &ranges, ReadValues readValues)
+	{
+		// The kept tuples in increasing order, each slab being read once
+		std::vector<uint64_t> readOrder(keptTuples.size());
+		std::iota(readOrder.begin(), readOrder.end(), 0);
+		if (!std::is_sorted(keptTuples.begin(), keptTuples.end()))
+		{
+			std::sort(readOrder.begin(), readOrder.end(), [&keptTuples](uint64_t first, uint64_t second)
+					  { return keptTuples[first] < keptTuples[second]; });
+		}
+
+		if (readOrder.empty())
+		{
+			return;
+		}
+		const uint64_t keptTupleEnd = std::min(keptTuples[readOrder.back()] + 1, tupleCount);
+		const uint64_t keptTupleSpan = keptTupleEnd - keptTuples[readOrder.front()] / chunkTupleCount * chunkTupleCount;
+		uint64_t slabTupleCount = std::max<uint64_t>(1, std::min<uint64_t>(keptTupleSpan, maxBufferSize / (componentCount * sizeof(T))));
+		if (slabTupleCount > chunkTupleCount && slabTupleCount < keptTupleSpan)
+		{
+			slabTupleCount -= slabTupleCount % chunkTupleCount;
+		}
+		// The slabs start at a chunk when they hold whole chunks
+		const uint64_t slabAlignment = slabTupleCount >= chunkTupleCount ? chunkTupleCount : 1;
+		std::unique_ptr<T[]> slabValues(new T[slabTupleCount * componentCount]);
+		std::vector<uint64_t>::const_iterator kept = readOrder.begin();
+		while (kept != readOrder.end())
+		{
+			const uint64_t slabFirstTuple = keptTuples[*kept] / slabAlignment * slabAlignment;
+			const uint64_t slabSize = std::min(slabTupleCount, keptTupleEnd - slabFirstTuple);
+			const uint64_t numValuesInEachDimension = slabSize * componentCount;
+			const uint64_t offsetInEachDimension = slabFirstTuple * componentCount;
+			readValues(slabValues.get(), &numValuesInEachDimension, &offsetInEachDimension);
+			for (; kept != readOrder.end() && keptTuples[*kept] < slabFirstTuple + slabSize; ++kept)
+			{
+				T const *tupleValues = slabValues.get() + (keptTuples[*kept] - slabFirstTuple) * componentCount;
+				std::copy(tupleValues, tupleValues + componentCount, keptValues + *kept * componentCount);
+				ranges.add(keptValues + *kept * componentCount);
+			}
+		}
+	}
+
+	/**
+	 * Read the values of some tuples of a patch in a new VtkArray, fesapi reading them partially as T values.
+	 * The patch is 1d, or 2d with the components of each tuple in its second dimension.
+	 * The ranges of the kept values are stored in the array.
+	 */
+	template <typename VtkArray, typename T>
+	vtkSmartPointer<vtkDataArray> readTuples(const RESQML2_NS::AbstractValuesProperty *valuesProperty, uint64_t patchIndex, const std::vector<uint64_t> &keptTuples, uint64_t tupleCount, uint32_t componentCount, uint64_t maxBufferSize, const std::string &name)
+	{
+		const uint64_t valueCount = keptTuples.size() * componentCount;
+		typename VtkArray::ValueType *values = new typename VtkArray::ValueType[valueCount]; // deleted by VTK data vtkSmartPointer
+		const unsigned int dimensionCount = valuesProperty->getDimensionsCountOfPatch(patchIndex);
+		const uint64_t chunkElementCount = getChunkElementCountOfPatch(valuesProperty, patchIndex);
+		const uint64_t chunkTupleCount = dimensionCount == 2 ? chunkElementCount : std::max<uint64_t>(1, chunkElementCount / componentCount);
+		TupleRanges ranges(componentCount);
+		readTuplesBySlabs<T>(values, keptTuples, tupleCount, componentCount, chunkTupleCount, maxBufferSize, ranges, [valuesProperty, patchIndex, dimensionCount, componentCount](T *slabValues, uint64_t const *numValues, uint64_t const *offsets)
+							 {
+								 if (dimensionCount == 2)
+								 {
+									 const uint64_t numValuesInEachDimension[2] = {numValues[0] / componentCount, componentCount};
+									 const uint64_t offsetInEachDimension[2] = {offsets[0] / componentCount, 0};
+									 readValuesOfPatch(valuesProperty, patchIndex, slabValues, numValuesInEachDimension, offsetInEachDimension, 2);
+								 }
+								 else
+								 {
+									 readValuesOfPatch(valuesProperty, patchIndex, slabValues, numValues, offsets);
+								 } });
+		vtkSmartPointer<vtkDataArray> dataArray = newDataArray<VtkArray>(values, valueCount, componentCount, name);
+		if (valueCount > 0)
+		{
+			storeRanges(dataArray, ranges.get());
+		}
+		return dataArray;
+	}
+}
+
+
+//----------------------------------------------------------------------------
+ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(const RESQML2_NS::AbstractValuesProperty *valuesProperty,
+														   uint64_t cellCount,
+														   uint64_t pointCount,
+														   uint32_t iCellCount,
+														   uint32_t jCellCount,
+														   uint32_t iBlockCellCount,
+														   uint32_t jBlockCellCount,
+														   uint32_t kBlockCellCount,
+														   uint32_t initIIndex,
+														   uint32_t initJIndex,
+														   uint32_t initKIndex,
+														   uint64_t patch_index,
+														   uint64_t maxReadBufferSize)
+{
+	uint64_t nbElement = 0;
+
+	const gsoap_eml2_3::eml23__IndexableElement element = valuesProperty->getAttachmentKind();
+	if (element == gsoap_eml2_3::eml23__IndexableElement::cells ||
+		element == gsoap_eml2_3::eml23__IndexableElement::triangles)
+	{
+		nbElement = cellCount;
+	}
+	else if (element == gsoap_eml2_3::eml23__IndexableElement::nodes)
+	{
+		nbElement = pointCount;
 	}
 	else
+	{
+		throw std::invalid_argument("Property indexable element must be points or cells.");
+	}
+
+	const uint32_t elementCountPerValue = valuesProperty->getElementCountPerValue();
+
+	const std::string typeProperty = valuesProperty->getXmlTag();
+	const bool continuous = typeProperty == RESQML2_NS::ContinuousProperty::XML_TAG;
+	if (!continuous &&
+		typeProperty != RESQML2_NS::DiscreteProperty::XML_TAG &&
+		typeProperty != RESQML2_NS::CategoricalProperty::XML_TAG)
 	{
 		vtkOutputWindowDisplayErrorText("property not supported...  (hdfDatatypeEnum)\n");
+		return;
+	}
+
+	const std::string name = valuesProperty->getTitle();
+	const Datatype datatype = getArrayDatatype(valuesProperty, continuous);
+	// The block is the whole grid : the values are read in their own datatype
+	if (valuesProperty->getValuesCountOfPatch(patch_index) == nbElement * elementCountPerValue)
+	{
+		this->dataArray = readPatch(valuesProperty, patch_index, datatype, nbElement * elementCountPerValue, elementCountPerValue, name);
+		return;
+	}
+
+	// fesapi only reads a block in float or in int32, the small integers being narrowed back to their own datatype. The double and the other integer values are read through the HDF proxy.
+	const BlockExtent block = {iCellCount, jCellCount, iBlockCellCount, jBlockCellCount, kBlockCellCount, initIIndex, initJIndex, elementCountPerValue};
+	if (continuous)
+	{
+		if (datatype == Datatype::FLOAT)
+		{
+			this->dataArray = readBlock<vtkFloatArray, float>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		}
+		else
+		{
+			this->dataArray = readBlock<vtkDoubleArray, double>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		}
+		return;
+	}
+	switch (datatype)
+	{
+	case Datatype::INT64:
+		this->dataArray = readBlock<Int64Array, int64_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		break;
+	case Datatype::UINT64:
+		this->dataArray = readBlock<UInt64Array, int64_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		break;
+	case Datatype::UINT32:
+		this->dataArray = readBlock<vtkUnsignedIntArray, int64_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		break;
+	case Datatype::INT16:
+		this->dataArray = readBlock<vtkShortArray, int32_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		break;
+	case Datatype::UINT16:
+		this->dataArray = readBlock<vtkUnsignedShortArray, int32_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		break;
+	case Datatype::INT8:
+		this->dataArray = readBlock<vtkSignedCharArray, int32_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		break;
+	case Datatype::UINT8:
+		this->dataArray = readBlock<vtkUnsignedCharArray, int32_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
+		break;
+	default:
+		this->dataArray = readBlock<vtkIntArray, int32_t>(valuesProperty, patch_index, block, initKIndex, maxReadBufferSize, name);
 	}
 }
 
@@ -143,7 +815,9 @@ ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(const RESQML2_NS::Abs
 ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(resqml2::AbstractValuesProperty const *valuesProperty,
 															uint64_t cellCount,
 															uint64_t pointCount,
-															uint64_t patch_index)	
+															uint64_t patch_index,
+															const std::vector<uint64_t> &keptTuples,
+															uint64_t maxReadBufferSize)
 {
 	uint64_t nbElement = 0;
 
@@ -164,7 +838,8 @@ ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(resqml2::AbstractValu
 
 	const uint32_t elementCountPerValue = valuesProperty->getElementCountPerValue();
 	const std::string name = valuesProperty->getTitle();
-	if (valuesProperty->getXmlTag() == resqml2::ContinuousProperty::XML_TAG)
+	const bool continuous = valuesProperty->getXmlTag() == resqml2::ContinuousProperty::XML_TAG;
+	if (continuous)
 	{
 		// defensive code
 		const unsigned int totalHDFElementcount = nbElement * elementCountPerValue;
@@ -172,31 +847,176 @@ ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(resqml2::AbstractValu
 		{
 			throw std::invalid_argument("Property values count of hdfDataset \"" + std::to_string(valuesProperty->getValuesCountOfPatch(patch_index)) + "\" does not match the indexable element count in the supporting representation\"" + std::to_string(totalHDFElementcount) + "\"");
 		}
+	}
+	else if (valuesProperty->getXmlTag() != resqml2::DiscreteProperty::XML_TAG &&
+			 (valuesProperty->getXmlTag() != resqml2::CategoricalProperty::XML_TAG ||
+			  static_cast<resqml2::CategoricalProperty const *>(valuesProperty)->getStringLookup() == nullptr))
+	{
+		throw std::invalid_argument("does not support property which are not discrete or categorical or continuous yet");
+	}
 
-		double *valuesDoubleSet = new double[totalHDFElementcount]; // deleted by VTK data vtkSmartPointer
-		valuesProperty->getDoubleValuesOfPatch(patch_index, valuesDoubleSet);
-
-		vtkSmartPointer<vtkDoubleArray> cellDataDouble = vtkSmartPointer<vtkDoubleArray>::New();
-		cellDataDouble->SetNumberOfComponents(elementCountPerValue);
-		cellDataDouble->SetName(name.c_str());
-		cellDataDouble->SetArray(valuesDoubleSet, nbElement * elementCountPerValue, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataDouble;
+	const Datatype datatype = getArrayDatatype(valuesProperty, continuous);
+	// Only some tuples of a 1d patch (or 2d with components) are read by bounded slabs, straight into the final array
+	const unsigned int dimensionCount = valuesProperty->getDimensionsCountOfPatch(patch_index);
+	if (!keptTuples.empty() && (dimensionCount == 1 || (dimensionCount == 2 && elementCountPerValue > 1)))
+	{
+		switch (datatype)
+		{
+		case Datatype::DOUBLE:
+			this->dataArray = readTuples<vtkDoubleArray, double>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::INT64:
+			this->dataArray = readTuples<Int64Array, int64_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::UINT64:
+			this->dataArray = readTuples<UInt64Array, int64_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::UINT32:
+			this->dataArray = readTuples<vtkUnsignedIntArray, int64_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::FLOAT:
+			this->dataArray = readTuples<vtkFloatArray, float>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::INT16:
+			this->dataArray = readTuples<vtkShortArray, int32_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::UINT16:
+			this->dataArray = readTuples<vtkUnsignedShortArray, int32_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::INT8:
+			this->dataArray = readTuples<vtkSignedCharArray, int32_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		case Datatype::UINT8:
+			this->dataArray = readTuples<vtkUnsignedCharArray, int32_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+			break;
+		default:
+			this->dataArray = readTuples<vtkIntArray, int32_t>(valuesProperty, patch_index, keptTuples, nbElement, elementCountPerValue, maxReadBufferSize, name);
+		}
+		return;
 	}
-	else if (valuesProperty->getXmlTag() == resqml2::DiscreteProperty::XML_TAG ||
-			 (valuesProperty->getXmlTag() == resqml2::CategoricalProperty::XML_TAG &&
-			  static_cast<resqml2::CategoricalProperty const *>(valuesProperty)->getStringLookup() != nullptr))
+
+	this->dataArray = readPatch(valuesProperty, patch_index, datatype, nbElement * elementCountPerValue, elementCountPerValue, name);
+	if (!keptTuples.empty())
 	{
-		int32_t*values = new int32_t[nbElement * elementCountPerValue]; // deleted by VTK data vtkSmartPointer
-		valuesProperty->getInt32ValuesOfPatch(patch_index, values);
+		keepTuples(keptTuples);
+	}
+}
 
-		vtkSmartPointer<vtkIntArray> cellDataInt = vtkSmartPointer<vtkIntArray>::New();
-		cellDataInt->SetNumberOfComponents(elementCountPerValue);
-		cellDataInt->SetName(name.c_str());
-		cellDataInt->SetArray(values, nbElement * elementCountPerValue, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataInt;
+// -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(resqml2::AbstractValuesProperty const *valuesProperty,
+															uint64_t tupleCount,
+															const std::function<vtkSmartPointer<vtkDataArray>()> &loader,
+															bool deferredLoading)
+{
+	if (!deferredLoading)
+	{
+		this->dataArray = loader();
+		const std::vector<double> statistics = getStatistics(valuesProperty, valuesProperty->getElementCountPerValue());
+		if (!statistics.empty() && this->dataArray != nullptr)
+		{
+			setRanges(statistics);
+		}
+		return;
 	}
-	else
+	this->deferred = true;
+
+	const std::string typeProperty = valuesProperty->getXmlTag();
+	const bool continuous = typeProperty == resqml2::ContinuousProperty::XML_TAG;
+	if (!continuous &&
+		typeProperty != resqml2::DiscreteProperty::XML_TAG &&
+		typeProperty != resqml2::CategoricalProperty::XML_TAG)
 	{
 		throw std::invalid_argument("does not support property which are not discrete or categorical or continuous yet");
 	}
+
+	// The VTK data type is the one of the loaded values, whole or partial read.
+	const uint32_t componentCount = valuesProperty->getElementCountPerValue();
+	this->ranges = getStatistics(valuesProperty, componentCount);
+	switch (getArrayDatatype(valuesProperty, continuous))
+	{
+	case Datatype::DOUBLE:
+		this->dataArray = newDeferredDataArray<double>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::FLOAT:
+		this->dataArray = newDeferredDataArray<float>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::INT64:
+		this->dataArray = newDeferredDataArray<Int64Array::ValueType>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::UINT64:
+		this->dataArray = newDeferredDataArray<UInt64Array::ValueType>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::UINT32:
+		this->dataArray = newDeferredDataArray<uint32_t>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::INT16:
+		this->dataArray = newDeferredDataArray<int16_t>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::UINT16:
+		this->dataArray = newDeferredDataArray<uint16_t>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::INT8:
+		this->dataArray = newDeferredDataArray<int8_t>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	case Datatype::UINT8:
+		this->dataArray = newDeferredDataArray<uint8_t>(tupleCount, componentCount, loader, this->ranges);
+		break;
+	default:
+		this->dataArray = newDeferredDataArray<int32_t>(tupleCount, componentCount, loader, this->ranges);
+	}
+	this->dataArray->SetName(valuesProperty->getTitle().c_str());
+}
+
+//----------------------------------------------------------------------------
+std::vector<double> ResqmlPropertyToVtkDataArray::getRanges()
+{
+	if (this->ranges.empty() && !this->deferred && this->dataArray != nullptr && this->dataArray->GetNumberOfTuples() > 0)
+	{
+		// The ranges computed by the partial reads while they copied the values, else a scan of the values
+		const std::vector<double> storedRanges = getStoredRanges(this->dataArray);
+		if (!storedRanges.empty())
+		{
+			setRanges(storedRanges);
+			return this->ranges;
+		}
+		RangeWorker worker;
+		if (!vtkArrayDispatch::Dispatch::Execute(this->dataArray, worker))
+		{
+			worker(this->dataArray.Get());
+		}
+		setRanges(worker.ranges);
+	}
+	return this->ranges;
 }
+
+//----------------------------------------------------------------------------
+void ResqmlPropertyToVtkDataArray::setRanges(const std::vector<double> &p_ranges)
+{
+	this->ranges = p_ranges;
+	if (this->dataArray != nullptr)
+	{
+		storeRanges(this->dataArray, this->ranges);
+	}
+}
+
+//----------------------------------------------------------------------------
+std::recursive_mutex &ResqmlPropertyToVtkDataArray::getReadMutex()
+{
+	static std::recursive_mutex readMutex;
+	return readMutex;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlPropertyToVtkDataArray::keepTuples(const std::vector<uint64_t> &tupleIndices)
+{
+	vtkSmartPointer<vtkDataArray> keptData = vtkSmartPointer<vtkDataArray>::Take(this->dataArray->NewInstance());
+	keptData->SetName(this->dataArray->GetName());
+	keptData->SetNumberOfComponents(this->dataArray->GetNumberOfComponents());
+	keptData->SetNumberOfTuples(tupleIndices.size());
+	for (size_t tupleIndex = 0; tupleIndex < tupleIndices.size(); ++tupleIndex)
+	{
+		keptData->SetTuple(tupleIndex, tupleIndices[tupleIndex], this->dataArray);
+	}
+	this->dataArray = keptData;
+}
+
@@ -23,6 +23,10 @@ under the License.
 #include <vtkSmartPointer.h>
 #include <vtkDataArray.h>
 
+#include <functional>
+#include <mutex>
+#include <vector>
+
 #include <fesapi/nsDefinitions.h>
 
 namespace RESQML2_NS
@@ -31,36 +35,96 @@ namespace RESQML2_NS
 }
 
 /** @brief	the data table of a property
+ *
+ * The VTK array keeps the HDF5 datatype of the values (for instance uint8 in a vtkUnsignedCharArray) when it suits the kind of property.
+ * Otherwise a discrete or categorical property is in a vtkIntArray, whole or partial read.
+ * A continuous property is in a vtkFloatArray if its values are float, else in a vtkDoubleArray.
  */
 
 class ResqmlPropertyToVtkDataArray
 {
 public:
 	/**
-	 * Constructor for multi-processor
+	 * Constructor for multi-processor : only the cells of the block [initIIndex, initIIndex + iBlockCellCount[ x [initJIndex, initJIndex + jBlockCellCount[ x [initKIndex, initKIndex + kBlockCellCount[
+	 * of an IJK grid of iCellCount x jCellCount columns are read.
+	 * The components of each cell value are read interleaved, from a 1d patch or from the last dimension of a 4d patch.
+	 *
+	 * @param maxReadBufferSize	The cap in bytes of the temporary buffer of the slabs of K layers.
 	 */
 	ResqmlPropertyToVtkDataArray(const RESQML2_NS::AbstractValuesProperty *resqmlProperty,
 								 uint64_t cellCount,
 								 uint64_t pointCount,
 								 uint32_t iCellCount,
 								 uint32_t jCellCount,
-								 uint32_t kCellCount,
+								 uint32_t iBlockCellCount,
+								 uint32_t jBlockCellCount,
+								 uint32_t kBlockCellCount,
+								 uint32_t initIIndex,
+								 uint32_t initJIndex,
 								 uint32_t initKIndex,
-								 uint64_t patch_index);
+								 uint64_t patch_index,
+								 uint64_t maxReadBufferSize);
 
 	/**
 	 * Constructor
+	 *
+	 * @param keptTuples	The index of the elements to read, in the order of the VTK tuples. Empty to read all the elements.
+	 *						The values of a 1d patch (or 2d with the components in the second dimension) are then read by slabs bounded by the maximum read buffer size,
+	 *						sized in multiples of the chunks of the HDF5 dataset.
+	 * @param maxReadBufferSize	The cap in bytes of the temporary buffer of these slabs.
 	 */
 	ResqmlPropertyToVtkDataArray(RESQML2_NS::AbstractValuesProperty const *resqmlProperty,
 								 uint64_t cellCount,
 								 uint64_t pointCount,
-								 uint64_t patch_index);
+								 uint64_t patch_index,
+								 const std::vector<uint64_t> &keptTuples = std::vector<uint64_t>(),
+								 uint64_t maxReadBufferSize = 256 * 1024 * 1024);
+
+	/**
+	 * Constructor from a loader of the values, for instance one of the other constructors.
+	 * In deferred loading, the loader is only called when a filter accesses the values for the first time.
+	 *
+	 * @param tupleCount	The count of tuples the loader returns.
+	 * @param deferredLoading	True to defer the call of the loader.
+	 */
+	ResqmlPropertyToVtkDataArray(RESQML2_NS::AbstractValuesProperty const *resqmlProperty,
+								 uint64_t tupleCount,
+								 const std::function<vtkSmartPointer<vtkDataArray>()> &loader,
+								 bool deferredLoading = false);
 
 	~ResqmlPropertyToVtkDataArray() = default;
 
 	vtkSmartPointer<vtkDataArray> getVtkData() { return dataArray; }
 
+	/**
+	 * Only keep the values of some elements (for instance the cells loaded by a process), in the given order.
+	 */
+	void keepTuples(const std::vector<uint64_t> &tupleIndices);
+
+	/**
+	 * Get the minimum and maximum of each component of the values, followed by the ones of their L2 norm if there are several components.
+	 * They are the statistics of the RESQML property if it has some, else the ones computed by the partial reads while they copied the values, else they are computed in a single pass over the values.
+	 * They are stored in the information of the VTK array (COMPONENT_RANGE, L2_NORM_RANGE) so that VTK does not compute them again.
+	 *
+	 * @return	Empty if the values are not loaded yet (deferred loading) or if there are none.
+	 */
+	std::vector<double> getRanges();
+
+	/**
+	 * Set the ranges of the values, for instance the ones got from another array of the same property, without computing them.
+	 */
+	void setRanges(const std::vector<double> &p_ranges);
+
+	/**
+	 * The lock of the fesapi and HDF5 reads, which are not thread safe : the reader requests, the deferred loading and the time series prefetch take it.
+	 * It is recursive since a deferred array may be loaded during a request.
+	 * A request pauses its own prefetch before taking it.
+	 */
+	static std::recursive_mutex &getReadMutex();
+
 private:
 	vtkSmartPointer<vtkDataArray> dataArray;
+	std::vector<double> ranges;
+	bool deferred = false;
 };
 #endif
@@ -0,0 +1,204 @@
+﻿/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#include "Mapping/ResqmlTimeSeriesPrefetcher.h"
+
+#include <algorithm>
+#include <exception>
+
+// include F2i-consulting Energistics Paraview Plugin
+#include "Mapping/ResqmlPropertyToVtkDataArray.h"
+
+//----------------------------------------------------------------------------
+ResqmlTimeSeriesPrefetcher::ResqmlTimeSeriesPrefetcher(size_t p_capacity)
+	: _capacity(p_capacity),
+	  _cache(),
+	  _cacheOrder(),
+	  _queue(),
+	  _pauseCount(0),
+	  _reading(false),
+	  _stopped(false)
+{
+}
+
+//----------------------------------------------------------------------------
+ResqmlTimeSeriesPrefetcher::~ResqmlTimeSeriesPrefetcher()
+{
+	{
+		std::lock_guard<std::mutex> w_lock(_mutex);
+		_stopped = true;
+	}
+	_condition.notify_all();
+	if (_thread.joinable())
+	{
+		_thread.join();
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::setCapacity(size_t p_capacity)
+{
+	std::lock_guard<std::mutex> w_lock(_mutex);
+	_capacity = p_capacity;
+	while (_cacheOrder.size() > _capacity)
+	{
+		_cache.erase(_cacheOrder.front());
+		_cacheOrder.pop_front();
+	}
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> ResqmlTimeSeriesPrefetcher::get(const Key &p_key) const
+{
+	std::lock_guard<std::mutex> w_lock(_mutex);
+	const auto w_it = _cache.find(p_key);
+	return w_it != _cache.end() ? w_it->second : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::insert(const Key &p_key, vtkSmartPointer<vtkDataArray> p_values)
+{
+	std::lock_guard<std::mutex> w_lock(_mutex);
+	cache(p_key, p_values);
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::prefetch(const std::vector<std::pair<Key, Loader>> &p_steps)
+{
+	{
+		std::lock_guard<std::mutex> w_lock(_mutex);
+		for (const auto &w_step : p_steps)
+		{
+			if (_cache.find(w_step.first) == _cache.end() &&
+				std::find_if(_queue.begin(), _queue.end(), [&w_step](const std::pair<Key, Loader> &w_queued)
+							 { return w_queued.first == w_step.first; }) == _queue.end())
+			{
+				_queue.push_back(w_step);
+			}
+		}
+		if (_queue.empty())
+		{
+			return;
+		}
+		if (!_thread.joinable())
+		{
+			_thread = std::thread(&ResqmlTimeSeriesPrefetcher::run, this);
+		}
+	}
+	_condition.notify_all();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::cancel()
+{
+	std::lock_guard<std::mutex> w_lock(_mutex);
+	_queue.clear();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::clear()
+{
+	std::unique_lock<std::mutex> w_lock(_mutex);
+	_queue.clear();
+	_condition.wait(w_lock, [this]()
+					{ return !_reading; });
+	_cache.clear();
+	_cacheOrder.clear();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::pause()
+{
+	std::unique_lock<std::mutex> w_lock(_mutex);
+	++_pauseCount;
+	_condition.wait(w_lock, [this]()
+					{ return !_reading; });
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::resume()
+{
+	{
+		std::lock_guard<std::mutex> w_lock(_mutex);
+		--_pauseCount;
+	}
+	_condition.notify_all();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::run()
+{
+	std::unique_lock<std::mutex> w_lock(_mutex);
+	while (true)
+	{
+		_condition.wait(w_lock, [this]()
+						{ return _stopped || (_pauseCount == 0 && !_queue.empty()); });
+		if (_stopped)
+		{
+			return;
+		}
+		const std::pair<Key, Loader> w_step = _queue.front();
+		_queue.pop_front();
+		if (_cache.find(w_step.first) != _cache.end())
+		{
+			continue;
+		}
+
+		_reading = true;
+		w_lock.unlock();
+		vtkSmartPointer<vtkDataArray> w_values;
+		try
+		{
+			std::lock_guard<std::recursive_mutex> w_readLock(ResqmlPropertyToVtkDataArray::getReadMutex());
+			w_values = w_step.second();
+		}
+		catch (const std::exception &)
+		{
+			// the step is read again by the reader request, which reports the error
+		}
+		w_lock.lock();
+		_reading = false;
+		if (w_values != nullptr)
+		{
+			cache(w_step.first, w_values);
+		}
+		_condition.notify_all();
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlTimeSeriesPrefetcher::cache(const Key &p_key, vtkSmartPointer<vtkDataArray> p_values)
+{
+	if (_capacity == 0)
+	{
+		return;
+	}
+	const auto w_it = _cache.find(p_key);
+	if (w_it != _cache.end())
+	{
+		w_it->second = p_values;
+		return;
+	}
+	_cache[p_key] = p_values;
+	_cacheOrder.push_back(p_key);
+	while (_cacheOrder.size() > _capacity)
+	{
+		_cache.erase(_cacheOrder.front());
+		_cacheOrder.pop_front();
+	}
+}
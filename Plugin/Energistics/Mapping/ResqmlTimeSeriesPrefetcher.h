@@ -0,0 +1,142 @@
+﻿/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+#ifndef __ResqmlTimeSeriesPrefetcher_h
+#define __ResqmlTimeSeriesPrefetcher_h
+
+// include system
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// include VTK library
+#include <vtkDataArray.h>
+#include <vtkSmartPointer.h>
+
+/** @brief	read the next time steps of the animated time series on a background thread
+ *
+ * The values read in advance, and the ones of the steps already displayed, are kept in a ring cache of bounded size,
+ * so that going back and forth through time does not read them again.
+ * fesapi and HDF5 not being thread safe, a step is read while holding ResqmlPropertyToVtkDataArray::getReadMutex(),
+ * which the reader requests also take once they have paused their own prefetch.
+ */
+class ResqmlTimeSeriesPrefetcher
+{
+public:
+	//                representation uuid    time series node  time index
+	typedef std::tuple<std::string, std::string, double> Key;
+	typedef std::function<vtkSmartPointer<vtkDataArray>()> Loader;
+
+	/**
+	 * Pause the prefetch during its scope.
+	 */
+	class ScopedPause
+	{
+	public:
+		explicit ScopedPause(ResqmlTimeSeriesPrefetcher &p_prefetcher) : _prefetcher(p_prefetcher) { _prefetcher.pause(); }
+		~ScopedPause() { _prefetcher.resume(); }
+
+	private:
+		ScopedPause(const ScopedPause &) = delete;
+		ScopedPause &operator=(const ScopedPause &) = delete;
+
+		ResqmlTimeSeriesPrefetcher &_prefetcher;
+	};
+
+	/**
+	 * @param p_capacity	The maximal count of arrays kept in the cache.
+	 */
+	explicit ResqmlTimeSeriesPrefetcher(size_t p_capacity = 8);
+
+	/**
+	 * Wait for the step being read, if any, and stop the background thread.
+	 */
+	~ResqmlTimeSeriesPrefetcher();
+
+	/**
+	 * Set the maximal count of arrays kept in the cache, the oldest ones being dropped first.
+	 */
+	void setCapacity(size_t p_capacity);
+
+	/**
+	 * @return the values of a step read in advance or already displayed, nullptr if they are not in the cache
+	 */
+	vtkSmartPointer<vtkDataArray> get(const Key &p_key) const;
+
+	/**
+	 * Keep the values of a step read by the reader request.
+	 */
+	void insert(const Key &p_key, vtkSmartPointer<vtkDataArray> p_values);
+
+	/**
+	 * Queue the reading of some steps, except the ones already in the cache or queued.
+	 */
+	void prefetch(const std::vector<std::pair<Key, Loader>> &p_steps);
+
+	/**
+	 * Drop the steps queued but not read yet.
+	 */
+	void cancel();
+
+	/**
+	 * Drop the queued steps and the cache, once the step being read, if any, is read.
+	 */
+	void clear();
+
+private:
+	ResqmlTimeSeriesPrefetcher(const ResqmlTimeSeriesPrefetcher &) = delete;
+	ResqmlTimeSeriesPrefetcher &operator=(const ResqmlTimeSeriesPrefetcher &) = delete;
+
+	/**
+	 * Wait for the step being read, if any, and do not read the next ones until resume is called.
+	 */
+	void pause();
+	void resume();
+
+	/**
+	 * Read the queued steps, one at a time, until the destruction.
+	 */
+	void run();
+
+	/**
+	 * Add an array to the cache, dropping the oldest ones beyond the capacity. _mutex must be held.
+	 */
+	void cache(const Key &p_key, vtkSmartPointer<vtkDataArray> p_values);
+
+	size_t _capacity;
+	std::map<Key, vtkSmartPointer<vtkDataArray>> _cache;
+	std::deque<Key> _cacheOrder; // the ring of the cached keys, the oldest first
+	std::deque<std::pair<Key, Loader>> _queue;
+
+	uint32_t _pauseCount;
+	bool _reading;
+	bool _stopped;
+	mutable std::mutex _mutex;
+	std::condition_variable _condition;
+	std::thread _thread; // started at the first prefetch
+};
+#endif
@@ -62,6 +62,8 @@ void ResqmlTriangulatedSetToVtkPartitionedDataSet::loadVtkObject()
 	for (auto patchIndex = 0; patchIndex < patchCount; ++patchIndex)
 	{
 		auto rep = new ResqmlTriangulatedToVtkPolyData(triangulatedSet, patchIndex, _procNumber, _maxProc);
+		rep->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
+		rep->loadVtkObject();
 		partition->SetPartition(patchIndex, rep->getOutput()->GetPartitionAsDataObject(0));
 		partition->GetMetaData(patchIndex)->Set(vtkCompositeDataSet::NAME(), ("Patch " + std::to_string(patchIndex)).c_str());
 		patchIndex_to_ResqmlTriangulated[patchIndex] = rep;
@@ -77,6 +79,8 @@ void ResqmlTriangulatedSetToVtkPartitionedDataSet::addDataArray(const std::strin
 
 	for (auto &map : patchIndex_to_ResqmlTriangulated)
 	{
+		map.second->setMaxReadBufferSize(_maxReadBufferSize);
+		map.second->setDeferredPropertyLoading(_deferredPropertyLoading);
 		map.second->addDataArray(p_uuid, map.first);
 		partition->SetPartition(map.first, map.second->getOutput()->GetPartitionAsDataObject(0));
 		partition->GetMetaData(map.first)->Set(vtkCompositeDataSet::NAME(), ("Patch " + std::to_string(map.first)).c_str());
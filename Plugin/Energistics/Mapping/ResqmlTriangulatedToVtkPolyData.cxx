@@ -44,8 +44,6 @@ ResqmlTriangulatedToVtkPolyData::ResqmlTriangulatedToVtkPolyData(const RESQML2_N
 	_pointCount = triangulated->getXyzPointCountOfPatch(patch_index);
 
 	_vtkData = vtkSmartPointer<vtkPartitionedDataSet>::New();
-
-	this->loadVtkObject();
 }
 
 //----------------------------------------------------------------------------
@@ -77,8 +75,6 @@ void ResqmlTriangulatedToVtkPolyData::loadVtkObject()
 	double *allXyzPoints = new double[_pointCount * 3]; // Will be deleted by VTK
 	triangulated->getXyzPointsOfPatchInGlobalCrs(this->patch_index, allXyzPoints);
 
-	vtkSmartPointer<vtkPoints> vtkPts = vtkSmartPointer<vtkPoints>::New();
-
 	const size_t coordCount = _pointCount * 3;
 	if (triangulated->getLocalCrs(0)->isDepthOriented())
 	{
@@ -88,11 +84,7 @@ void ResqmlTriangulatedToVtkPolyData::loadVtkObject()
 		}
 	}
 
-	vtkSmartPointer<vtkDoubleArray> vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
-	vtkUnderlyingArray->SetNumberOfComponents(3);
-	// Take ownership of the underlying C array
-	vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-	vtkPts->SetData(vtkUnderlyingArray);
+	vtkSmartPointer<vtkPoints> vtkPts = createVtkPoints(allXyzPoints, _pointCount);
 	vtk_polydata->SetPoints(vtkPts);
 
 	// CELLS
@@ -110,6 +102,8 @@ void ResqmlTriangulatedToVtkPolyData::loadVtkObject()
 	}
 	vtk_polydata->SetPolys(triangulatedRepresentationTriangles);
 
+	addGeometryOriginToFieldData(vtk_polydata);
+
 	_vtkData->SetPartition(0, vtk_polydata);
 	_vtkData->Modified();
 }
@@ -48,11 +48,12 @@ under the License.
 #include "ResqmlUnstructuredGridToVtkUnstructuredGrid.h"
 
 //----------------------------------------------------------------------------
-ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(const RESQML2_NS::SubRepresentation *subRep, ResqmlUnstructuredGridToVtkUnstructuredGrid *support, uint32_t p_procNumber, uint32_t p_maxProc)
+ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(const RESQML2_NS::SubRepresentation *subRep, ResqmlUnstructuredGridToVtkUnstructuredGrid *support, uint32_t p_procNumber, uint32_t p_maxProc, bool p_compactPoints)
 	: ResqmlAbstractRepresentationToVtkPartitionedDataSet(subRep,
 		p_procNumber,
 		p_maxProc),
-	mapperUnstructuredGrid(support)
+	mapperUnstructuredGrid(support),
+	_compactPoints(p_compactPoints)
 {
 	_iCellCount = subRep->getElementCountOfPatch(0);
 	_pointCount = subRep->getSupportingRepresentation(0)->getXyzPointCountOfAllPatches();
@@ -87,76 +88,37 @@ void ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::loadVtkObject()
 	if (indexable_element == gsoap_eml2_3::eml23__IndexableElement::cells)
 	{
     vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
-		vtk_unstructuredGrid->Allocate(subRep->getElementCountOfPatch(0));
-		vtk_unstructuredGrid->SetPoints(this->getMapperVtkPoint());
 
-		supportingGrid->loadGeometry();
 		// CELLS
 		const uint64_t cellCount = subRep->getElementCountOfPatch(0);
-		uint64_t const *cumulativeFaceCountPerCell = supportingGrid->isFaceCountOfCellsConstant()
-						? nullptr
-						: supportingGrid->getCumulativeFaceCountPerCell(); // This pointer is owned and managed by FESAPI
-		std::unique_ptr<unsigned char[]> cellFaceNormalOutwardlyDirected(new unsigned char[cumulativeFaceCountPerCell == nullptr
-				   ? supportingGrid->getCellCount() * supportingGrid->getConstantFaceCountOfCells()
-				   : cumulativeFaceCountPerCell[supportingGrid->getCellCount() - 1]]);
-
-		supportingGrid->getCellFaceIsRightHanded(cellFaceNormalOutwardlyDirected.get());
 		auto maxCellIndex = (_procNumber + 1) * cellCount / _maxProc;
 
 		std::unique_ptr<uint64_t[]> elementIndices(new uint64_t[cellCount]);
 		subRep->getElementIndicesOfPatch(0, 0, elementIndices.get());
 
-		for (uint64_t cellIndex = _procNumber * cellCount / _maxProc; cellIndex < maxCellIndex; ++cellIndex)
-		{
-			bool isOptimizedCell = false;
-
-			const uint64_t localFaceCount = supportingGrid->getFaceCountOfCell(elementIndices[cellIndex]);
-
-			// Following https://kitware.github.io/vtk-examples/site/VTKBook/05Chapter5/#Figure%205-2
-			if (localFaceCount == 4)
-			{ // VTK_TETRA
-				this->mapperUnstructuredGrid->cellVtkTetra(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-				isOptimizedCell = true;
-			}
-			else if (localFaceCount == 5)
-			{ // VTK_WEDGE or VTK_PYRAMID
-				this->mapperUnstructuredGrid->cellVtkWedgeOrPyramid(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-				isOptimizedCell = true;
-			}
-			else if (localFaceCount == 6)
-			{ // VTK_HEXAHEDRON
-				isOptimizedCell = this->mapperUnstructuredGrid->cellVtkHexahedron(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-			}
-			else if (localFaceCount == 7)
-			{ // VTK_PENTAGONAL_PRISM
-				isOptimizedCell = this->mapperUnstructuredGrid->cellVtkPentagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-			}
-			else if (localFaceCount == 8)
-			{ // VTK_HEXAGONAL_PRISM
-				isOptimizedCell = this->mapperUnstructuredGrid->cellVtkHexagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-			}
+		// The cells are copied from the topology of the supporting grid, which is converted only once for all its subrepresentations if it is not partitioned
+		const std::vector<uint64_t> cells(elementIndices.get() + _procNumber * cellCount / _maxProc, elementIndices.get() + maxCellIndex);
+		this->mapperUnstructuredGrid->getTopologyOfCells(cells)->setCellsOf(vtk_unstructuredGrid);
 
-			if (!isOptimizedCell)
+		// POINTS
+		if (this->mapperUnstructuredGrid->_maxProc > 1)
+		{
+			// The points of a partitioned supporting grid are only the nodes of its own cells : the subrepresentation reads the nodes of its cells
+			this->mapperUnstructuredGrid->registerSubRep();
+			setReferencedPoints(vtk_unstructuredGrid->GetCells());
+			compactPointIds(vtk_unstructuredGrid);
+			vtk_unstructuredGrid->SetPoints(this->mapperUnstructuredGrid->createPointsOfNodes(_vtkPointToResqmlPoint));
+			addOriginalPointIds(vtk_unstructuredGrid);
+		}
+		else
+		{
+			vtk_unstructuredGrid->SetPoints(this->getMapperVtkPoint());
+			if (_compactPoints)
 			{
-        vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();
-
-				// For polyhedron cell, a special ptIds input format is required : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...)
-				idList->InsertNextId(localFaceCount);
-				for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
-				{
-					const unsigned int localNodeCount = supportingGrid->getNodeCountOfFaceOfCell(elementIndices[cellIndex], localFaceIndex);
-					idList->InsertNextId(localNodeCount);
-					uint64_t const *nodeIndices = supportingGrid->getNodeIndicesOfFaceOfCell(elementIndices[cellIndex], localFaceIndex);
-					for (unsigned int i = 0; i < localNodeCount; ++i)
-					{
-						idList->InsertNextId(nodeIndices[i]);
-					}
-				}
-
-				vtk_unstructuredGrid->InsertNextCell(VTK_POLYHEDRON, idList);
+				keepReferencedPointsOnly(vtk_unstructuredGrid, vtk_unstructuredGrid->GetPoints());
 			}
 		}
-		supportingGrid->unloadGeometry();
+		addGeometryOriginToFieldData(vtk_unstructuredGrid);
 
 		_vtkData->SetPartition(0, vtk_unstructuredGrid);
 		_vtkData->Modified();
@@ -164,7 +126,6 @@ void ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::loadVtkObject()
 	else if (indexable_element == gsoap_eml2_3::eml23__IndexableElement::faces)
 	{
 		vtkSmartPointer<vtkPolyData> vtk_polydata = vtkSmartPointer<vtkPolyData>::New();
-		vtk_polydata->SetPoints(this->getMapperVtkPoint());
 
     // FACES
 		const uint64_t gridFaceCount = supportingGrid->getFaceCount();
@@ -195,7 +156,23 @@ void ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::loadVtkObject()
 			polys->InsertNextCell(nodes);
 		}
 
+		// POINTS
+		if (this->mapperUnstructuredGrid->_maxProc > 1)
+		{
+			// The points of a partitioned supporting grid are only the nodes of its own cells : the subrepresentation reads the nodes of its faces
+			this->mapperUnstructuredGrid->registerSubRep();
+			setReferencedPoints(polys);
+			compactPointIds(polys);
+			vtk_polydata->SetPoints(this->mapperUnstructuredGrid->createPointsOfNodes(_vtkPointToResqmlPoint));
+			addOriginalPointIds(vtk_polydata);
+		}
+		else
+		{
+			vtk_polydata->SetPoints(this->getMapperVtkPoint());
+		}
+
 		vtk_polydata->SetPolys(polys);
+		addGeometryOriginToFieldData(vtk_polydata);
 
 		_vtkData->SetPartition(0, vtk_polydata);
 		_vtkData->Modified();
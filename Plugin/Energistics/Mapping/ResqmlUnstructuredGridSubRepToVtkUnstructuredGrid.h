@@ -42,7 +42,7 @@ public:
 	/**
 	 * Constructor
 	 */
-	ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(const RESQML2_NS::SubRepresentation *unstructuredGridSubRep, ResqmlUnstructuredGridToVtkUnstructuredGrid *support, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1);
+	ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(const RESQML2_NS::SubRepresentation *unstructuredGridSubRep, ResqmlUnstructuredGridToVtkUnstructuredGrid *support, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1, bool p_compactPoints = false);
 
 	/**
 	 * load vtkDataSet with resqml data
@@ -58,6 +58,9 @@ protected:
 	const RESQML2_NS::SubRepresentation *getResqmlData() const;
 	ResqmlUnstructuredGridToVtkUnstructuredGrid *mapperUnstructuredGrid;
 
+	// Only keep the points of the supporting grid which are referenced by the cells
+	bool _compactPoints;
+
 private:
 	vtkSmartPointer<vtkPoints> getMapperVtkPoint();
 };
@@ -18,6 +18,11 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "Mapping/ResqmlUnstructuredGridToVtkUnstructuredGrid.h"
 
+// include system
+#include <algorithm>
+#include <array>
+#include <numeric>
+
 // VTK
 #include <vtkCellData.h>
 #include <vtkPointData.h>
@@ -32,18 +37,51 @@ under the License.
 #include <vtkUnstructuredGrid.h>
 #include <vtkPyramid.h>
 #include <vtkWedge.h>
-#include <vtkIdList.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocal.h>
 
 // FESAPI
+#include <fesapi/common/DataObjectRepository.h>
+#include <fesapi/eml2/AbstractHdfProxy.h>
 #include <fesapi/resqml2/UnstructuredGridRepresentation.h>
 #include <fesapi/resqml2/AbstractLocal3dCrs.h>
 
+namespace
+{
+	/**
+	 * Count of points of the linear VTK cells the RESQML cells are mapped to.
+	 */
+	vtkIdType getNodeCountOfVtkCellType(unsigned char vtkCellType)
+	{
+		switch (vtkCellType)
+		{
+		case VTK_TETRA:
+			return 4;
+		case VTK_PYRAMID:
+			return 5;
+		case VTK_WEDGE:
+			return 6;
+		case VTK_HEXAHEDRON:
+			return 8;
+		case VTK_PENTAGONAL_PRISM:
+			return 10;
+		case VTK_HEXAGONAL_PRISM:
+			return 12;
+		default:
+			throw std::invalid_argument("The VTK cell type " + std::to_string(vtkCellType) + " has no constant count of points.");
+		}
+	}
+}
+
 //----------------------------------------------------------------------------
-ResqmlUnstructuredGridToVtkUnstructuredGrid::ResqmlUnstructuredGridToVtkUnstructuredGrid(const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid, uint32_t p_procNumber, uint32_t p_maxProc)
+ResqmlUnstructuredGridToVtkUnstructuredGrid::ResqmlUnstructuredGridToVtkUnstructuredGrid(const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid, uint32_t p_procNumber, uint32_t p_maxProc, bool p_ghostCellLayer)
 	: ResqmlAbstractRepresentationToVtkPartitionedDataSet(unstructuredGrid,
 														  p_procNumber,
 														  p_maxProc),
-	  points(vtkSmartPointer<vtkPoints>::New())
+	  points(vtkSmartPointer<vtkPoints>::New()),
+	  _ghostCellLayer(p_ghostCellLayer)
 {
 	_pointCount = unstructuredGrid->getXyzPointCountOfAllPatches();
 	_iCellCount = unstructuredGrid->getCellCount();
@@ -64,91 +102,477 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::loadVtkObject()
 {
 	vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
 	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
+	const uint64_t cellCount = unstructuredGrid->getCellCount();
 
-	vtk_unstructuredGrid->AllocateExact(unstructuredGrid->getCellCount(), unstructuredGrid->getXyzPointCountOfAllPatches());
+	// CELLS
+	std::vector<uint64_t> loadedCells;
+	uint64_t ownedCellCount = 0;
+	std::shared_ptr<const Topology> topology;
+	if (_maxProc < 2)
+	{
+		// The topology of the whole grid is shared with the mappers of its subrepresentations
+		topology = getTopology();
+	}
+	else
+	{
+		const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->loadGeometry();
+		loadedCells = getLoadedCells(ownedCellCount);
+		// A partitioned grid only keeps the nodes of its cells
+		if (this->points->GetNumberOfPoints() < 1)
+		{
+			_vtkPointToResqmlPoint = getNodesOfCells(loadedCells);
+		}
+		topology = convertCells(loadedCells);
+		const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->unloadGeometry();
+	}
 
 	// POINTS
 	vtk_unstructuredGrid->SetPoints(this->getVtkPoints());
+	topology->setCellsOf(vtk_unstructuredGrid);
 
+	if (!_vtkPointToResqmlPoint.empty())
+	{
+		compactPointIds(vtk_unstructuredGrid);
+
+		// The RESQML node index of each VTK point, for later joins between the pieces
+		vtkSmartPointer<vtkIdTypeArray> globalPointIds = vtkSmartPointer<vtkIdTypeArray>::New();
+		globalPointIds->SetName("GlobalPointIds");
+		globalPointIds->SetNumberOfValues(_vtkPointToResqmlPoint.size());
+		std::copy(_vtkPointToResqmlPoint.begin(), _vtkPointToResqmlPoint.end(), globalPointIds->GetPointer(0));
+		vtk_unstructuredGrid->GetPointData()->SetGlobalIds(globalPointIds);
+	}
+
+	if (ownedCellCount < loadedCells.size())
+	{
+		unsigned char *ghosts = vtk_unstructuredGrid->AllocateCellGhostArray()->GetPointer(0);
+		std::fill(ghosts + ownedCellCount, ghosts + loadedCells.size(), static_cast<unsigned char>(vtkDataSetAttributes::DUPLICATECELL));
+	}
+	// The properties must be read for the loaded cells only
+	_vtkCellToResqmlCell.clear();
+	if (!loadedCells.empty() && loadedCells.size() != cellCount)
+	{
+		_vtkCellToResqmlCell = loadedCells;
+	}
+
+	addGeometryOriginToFieldData(vtk_unstructuredGrid);
+
+	_vtkData->SetPartition(0, vtk_unstructuredGrid);
+	_vtkData->Modified();
+}
+
+//----------------------------------------------------------------------------
+std::shared_ptr<const ResqmlUnstructuredGridToVtkUnstructuredGrid::Topology> ResqmlUnstructuredGridToVtkUnstructuredGrid::getTopology()
+{
+	if (_topology == nullptr)
+	{
+		const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
+		std::vector<uint64_t> cells(unstructuredGrid->getCellCount());
+		std::iota(cells.begin(), cells.end(), 0);
+		const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->loadGeometry();
+		_topology = convertCells(cells);
+		const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->unloadGeometry();
+	}
+	return _topology;
+}
+
+//----------------------------------------------------------------------------
+std::shared_ptr<const ResqmlUnstructuredGridToVtkUnstructuredGrid::Topology> ResqmlUnstructuredGridToVtkUnstructuredGrid::getTopologyOfCells(const std::vector<uint64_t> &p_cells)
+{
+	if (_topology != nullptr)
+	{
+		return std::make_shared<const Topology>(_topology->extract(p_cells));
+	}
+
+	// The grid itself is not loaded (for instance the hidden support of a subrepresentation) or is partitioned : only convert the asked cells
+	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
 	const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->loadGeometry();
+	std::shared_ptr<const Topology> topology = convertCells(p_cells);
+	const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->unloadGeometry();
+	return topology;
+}
 
+//----------------------------------------------------------------------------
+std::vector<uint64_t> ResqmlUnstructuredGridToVtkUnstructuredGrid::getLoadedCells(uint64_t &p_ownedCellCount) const
+{
+	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
 	const uint64_t cellCount = unstructuredGrid->getCellCount();
+	const uint64_t initCellIndex = _procNumber * cellCount / _maxProc;
+	const uint64_t maxCellIndex = (_procNumber + 1) * cellCount / _maxProc;
+
+	std::vector<uint64_t> loadedCells(maxCellIndex - initCellIndex);
+	std::iota(loadedCells.begin(), loadedCells.end(), initCellIndex);
+	p_ownedCellCount = loadedCells.size();
+	if (!_ghostCellLayer || _maxProc < 2 || loadedCells.empty())
+	{
+		return loadedCells;
+	}
+
+	// One layer of ghost cells : the cells of the other processes which share at least one node with a cell of this process
+	auto nodeIsShared = [unstructuredGrid](uint64_t cellIndex, const std::vector<bool> &nodeIsOwned) -> bool
+	{
+		const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+		for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+		{
+			const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
+			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
+			if (std::any_of(nodeIndices, nodeIndices + localNodeCount, [&nodeIsOwned](uint64_t nodeIndex)
+							{ return nodeIsOwned[nodeIndex]; }))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	std::vector<bool> nodeIsOwned(_pointCount, false);
+	for (uint64_t cellIndex = initCellIndex; cellIndex < maxCellIndex; ++cellIndex)
+	{
+		const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+		for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+		{
+			const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
+			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
+			for (uint64_t i = 0; i < localNodeCount; ++i)
+			{
+				nodeIsOwned[nodeIndices[i]] = true;
+			}
+		}
+	}
+	for (uint64_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+	{
+		if ((cellIndex < initCellIndex || cellIndex >= maxCellIndex) && nodeIsShared(cellIndex, nodeIsOwned))
+		{
+			loadedCells.push_back(cellIndex);
+		}
+	}
+
+	return loadedCells;
+}
+
+//----------------------------------------------------------------------------
+std::shared_ptr<const ResqmlUnstructuredGridToVtkUnstructuredGrid::Topology> ResqmlUnstructuredGridToVtkUnstructuredGrid::convertCells(const std::vector<uint64_t> &p_cells) const
+{
+	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
+	const vtkIdType cellCount = p_cells.size();
+
+	const uint64_t gridCellCount = unstructuredGrid->getCellCount();
 	uint64_t const *cumulativeFaceCountPerCell = unstructuredGrid->isFaceCountOfCellsConstant()
 													 ? nullptr
 													 : unstructuredGrid->getCumulativeFaceCountPerCell(); // This pointer is owned and managed by FESAPI
 	const uint64_t faceCount = cumulativeFaceCountPerCell == nullptr
-								   ? cellCount * unstructuredGrid->getConstantFaceCountOfCells()
-								   : cumulativeFaceCountPerCell[cellCount - 1];
-	std::unique_ptr<unsigned char[]> cellFaceNormalOutwardlyDirected(new unsigned char[faceCount]);
+								   ? gridCellCount * unstructuredGrid->getConstantFaceCountOfCells()
+								   : cumulativeFaceCountPerCell[gridCellCount - 1];
+	std::unique_ptr<unsigned char[]> cellFaceIsRightHanded(new unsigned char[faceCount]);
 
-	unstructuredGrid->getCellFaceIsRightHanded(cellFaceNormalOutwardlyDirected.get());
+	unstructuredGrid->getCellFaceIsRightHanded(cellFaceIsRightHanded.get());
 	auto *crs = unstructuredGrid->getLocalCrs(0);
 	if (!crs->isPartial() && crs->isDepthOriented())
 	{
 		for (size_t i = 0; i < faceCount; ++i)
 		{
-			cellFaceNormalOutwardlyDirected[i] = !cellFaceNormalOutwardlyDirected[i];
+			cellFaceIsRightHanded[i] = !cellFaceIsRightHanded[i];
 		}
 	}
+	unsigned char const *cellFaceNormalOutwardlyDirected = cellFaceIsRightHanded.get();
 
-	auto maxCellIndex = (_procNumber + 1) * cellCount / _maxProc;
+	// First pass : the VTK cell types and the point count of each cell, the cells being independent from each other
+	vtkSmartPointer<vtkUnsignedCharArray> cellTypes = vtkSmartPointer<vtkUnsignedCharArray>::New();
+	cellTypes->SetNumberOfValues(cellCount);
+	unsigned char *types = cellTypes->GetPointer(0);
+	vtkSmartPointer<vtkIdTypeArray> offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+	offsets->SetNumberOfValues(cellCount + 1);
+	vtkIdType *cellOffsets = offsets->GetPointer(0);
+	cellOffsets[0] = 0;
+	std::vector<vtkIdType> faceStreamSizes(cellCount, 0);
+	vtkSMPThreadLocal<std::vector<uint64_t>> polyhedronNodes; // scratch of each thread
+	vtkSMPTools::For(0, cellCount, [this, &p_cells, types, cellOffsets, &faceStreamSizes, &polyhedronNodes](vtkIdType cellBegin, vtkIdType cellEnd)
+					 {
+						 std::vector<uint64_t> &nodes = polyhedronNodes.Local();
+						 for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
+						 {
+							 types[cellId] = getVtkCellType(p_cells[cellId]);
+							 if (types[cellId] == VTK_POLYHEDRON)
+							 {
+								 faceStreamSizes[cellId] = getPolyhedronNodes(p_cells[cellId], nodes);
+								 cellOffsets[cellId + 1] = nodes.size();
+							 }
+							 else
+							 {
+								 cellOffsets[cellId + 1] = types[cellId] == VTK_EMPTY_CELL ? 0 : getNodeCountOfVtkCellType(types[cellId]);
+							 }
+						 }
+					 });
 
-	for (uint64_t cellIndex = _procNumber * cellCount / _maxProc; cellIndex < maxCellIndex; ++cellIndex)
+	unsigned char const *malformedCell = std::find(types, types + cellCount, VTK_EMPTY_CELL);
+	if (malformedCell != types + cellCount)
 	{
-		bool isOptimizedCell = false;
-
-		const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+		throw std::invalid_argument("The cell index " + std::to_string(p_cells[malformedCell - types]) + " is malformed : 5 faces but not a pyramid, not a wedge.");
+	}
 
-		// Following https://kitware.github.io/vtk-examples/site/VTKBook/05Chapter5/#Figure%205-2
-		if (localFaceCount == 4)
-		{ // VTK_TETRA
-			cellVtkTetra(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
-			isOptimizedCell = true;
-		}
-		else if (localFaceCount == 5)
-		{ // VTK_WEDGE or VTK_PYRAMID
-			cellVtkWedgeOrPyramid(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
-			isOptimizedCell = true;
-		}
-		else if (localFaceCount == 6)
-		{ // VTK_HEXAHEDRON
-			isOptimizedCell = cellVtkHexahedron(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
+	// Prefix sums : the offsets of the cells in the flat connectivity array and of the polyhedra in the face stream
+	std::partial_sum(cellOffsets + 1, cellOffsets + cellCount + 1, cellOffsets + 1);
+	vtkSmartPointer<vtkIdTypeArray> faceLocations;
+	vtkSmartPointer<vtkIdTypeArray> faces;
+	vtkIdType *locations = nullptr;
+	vtkIdType *faceStream = nullptr;
+	const vtkIdType faceStreamSize = std::accumulate(faceStreamSizes.begin(), faceStreamSizes.end(), static_cast<vtkIdType>(0));
+	if (faceStreamSize > 0)
+	{
+		faceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+		faceLocations->SetNumberOfValues(cellCount);
+		locations = faceLocations->GetPointer(0);
+		vtkIdType faceStreamOffset = 0;
+		for (vtkIdType cellId = 0; cellId < cellCount; ++cellId)
+		{
+			locations[cellId] = faceStreamSizes[cellId] > 0 ? faceStreamOffset : -1;
+			faceStreamOffset += faceStreamSizes[cellId];
 		}
-		else if (localFaceCount == 7)
-		{ // VTK_PENTAGONAL_PRISM
-			isOptimizedCell = cellVtkPentagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
+		faces = vtkSmartPointer<vtkIdTypeArray>::New();
+		faces->SetNumberOfValues(faceStreamSize);
+		faceStream = faces->GetPointer(0);
+	}
+
+	// Second pass : each cell fills its own part of the connectivity and of the face stream
+	vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+	connectivity->SetNumberOfValues(cellOffsets[cellCount]);
+	vtkIdType *cellNodes = connectivity->GetPointer(0);
+	vtkSMPTools::For(0, cellCount, [this, unstructuredGrid, &p_cells, types, cellOffsets, cellNodes, locations, faceStream, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, &polyhedronNodes](vtkIdType cellBegin, vtkIdType cellEnd)
+					 {
+						 std::vector<uint64_t> &nodes = polyhedronNodes.Local();
+						 for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
+						 {
+							 const uint64_t cellIndex = p_cells[cellId];
+							 vtkIdType *nodesOfCell = cellNodes + cellOffsets[cellId];
+							 switch (types[cellId])
+							 {
+							 case VTK_TETRA:
+								 cellVtkTetra(cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex, nodesOfCell);
+								 break;
+							 case VTK_WEDGE:
+							 case VTK_PYRAMID:
+								 cellVtkWedgeOrPyramid(cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex, nodesOfCell);
+								 break;
+							 case VTK_HEXAHEDRON:
+								 cellVtkHexahedron(cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex, nodesOfCell);
+								 break;
+							 case VTK_PENTAGONAL_PRISM:
+								 cellVtkPentagonalPrism(cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex, nodesOfCell);
+								 break;
+							 case VTK_HEXAGONAL_PRISM:
+								 cellVtkHexagonalPrism(cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex, nodesOfCell);
+								 break;
+							 default:
+							 {
+								 // VTK_POLYHEDRON : the cell points then (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...) in the face stream
+								 getPolyhedronNodes(cellIndex, nodes);
+								 std::copy(nodes.begin(), nodes.end(), nodesOfCell);
+								 vtkIdType *faceStreamOfCell = faceStream + locations[cellId];
+								 const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+								 *faceStreamOfCell++ = localFaceCount;
+								 for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+								 {
+									 const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
+									 uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
+									 *faceStreamOfCell++ = localNodeCount;
+									 faceStreamOfCell = std::copy(nodeIndices, nodeIndices + localNodeCount, faceStreamOfCell);
+								 }
+							 }
+							 }
+						 }
+					 });
+
+	std::shared_ptr<Topology> topology = std::make_shared<Topology>();
+	topology->cellTypes = cellTypes;
+	topology->offsets = offsets;
+	topology->connectivity = connectivity;
+	topology->faceLocations = faceLocations;
+	topology->faces = faces;
+	return topology;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::Topology::setCellsOf(vtkUnstructuredGrid *p_unstructuredGrid) const
+{
+	vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+	cells->SetData(offsets, connectivity);
+	if (faces != nullptr)
+	{
+		p_unstructuredGrid->SetCells(cellTypes, cells, faceLocations, faces);
+	}
+	else
+	{
+		p_unstructuredGrid->SetCells(cellTypes, cells);
+	}
+}
+
+//----------------------------------------------------------------------------
+ResqmlUnstructuredGridToVtkUnstructuredGrid::Topology ResqmlUnstructuredGridToVtkUnstructuredGrid::Topology::extract(const std::vector<uint64_t> &p_cells) const
+{
+	const vtkIdType cellCount = p_cells.size();
+	vtkIdType const *cellOffsets = offsets->GetPointer(0);
+	vtkIdType const *locations = faceLocations == nullptr ? nullptr : faceLocations->GetPointer(0);
+	vtkIdType const *faceStream = faces == nullptr ? nullptr : faces->GetPointer(0);
+
+	// The size of the face stream of a polyhedron : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...)
+	auto faceStreamSizeOf = [locations, faceStream](uint64_t cellIndex) -> vtkIdType
+	{
+		if (locations == nullptr || locations[cellIndex] < 0)
+		{
+			return 0;
 		}
-		else if (localFaceCount == 8)
-		{ // VTK_HEXAGONAL_PRISM
-			isOptimizedCell = cellVtkHexagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
+		vtkIdType const *faceStreamOfCell = faceStream + locations[cellIndex];
+		vtkIdType position = 1;
+		for (vtkIdType localFaceIndex = 0; localFaceIndex < faceStreamOfCell[0]; ++localFaceIndex)
+		{
+			position += 1 + faceStreamOfCell[position];
 		}
+		return position;
+	};
 
-		if (!isOptimizedCell)
-		{
-			vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();
+	Topology result;
+	result.cellTypes = vtkSmartPointer<vtkUnsignedCharArray>::New();
+	result.cellTypes->SetNumberOfValues(cellCount);
+	result.offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+	result.offsets->SetNumberOfValues(cellCount + 1);
+	vtkIdType *resultOffsets = result.offsets->GetPointer(0);
+	resultOffsets[0] = 0;
+	vtkIdType resultFaceStreamSize = 0;
+	for (vtkIdType cellId = 0; cellId < cellCount; ++cellId)
+	{
+		const uint64_t cellIndex = p_cells[cellId];
+		result.cellTypes->SetValue(cellId, cellTypes->GetValue(cellIndex));
+		resultOffsets[cellId + 1] = resultOffsets[cellId] + cellOffsets[cellIndex + 1] - cellOffsets[cellIndex];
+		resultFaceStreamSize += faceStreamSizeOf(cellIndex);
+	}
 
-			// For polyhedron cell, a special ptIds input format is required : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...)
-			idList->InsertNextId(localFaceCount);
-			for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+	result.connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+	result.connectivity->SetNumberOfValues(resultOffsets[cellCount]);
+	vtkIdType *resultCellNodes = result.connectivity->GetPointer(0);
+	vtkIdType const *cellNodes = connectivity->GetPointer(0);
+	vtkSMPTools::For(0, cellCount, [&p_cells, cellOffsets, cellNodes, resultOffsets, resultCellNodes](vtkIdType cellBegin, vtkIdType cellEnd)
+					 {
+						 for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
+						 {
+							 std::copy(cellNodes + cellOffsets[p_cells[cellId]], cellNodes + cellOffsets[p_cells[cellId] + 1], resultCellNodes + resultOffsets[cellId]);
+						 }
+					 });
+
+	if (resultFaceStreamSize > 0)
+	{
+		result.faceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+		result.faceLocations->SetNumberOfValues(cellCount);
+		result.faces = vtkSmartPointer<vtkIdTypeArray>::New();
+		result.faces->SetNumberOfValues(resultFaceStreamSize);
+		vtkIdType *resultFaceStream = result.faces->GetPointer(0);
+		for (vtkIdType cellId = 0; cellId < cellCount; ++cellId)
+		{
+			const vtkIdType faceStreamSize = faceStreamSizeOf(p_cells[cellId]);
+			if (faceStreamSize > 0)
 			{
-				const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
-				idList->InsertNextId(localNodeCount);
-				uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
-				for (size_t i = 0; i < localNodeCount; ++i)
-				{
-					idList->InsertNextId(nodeIndices[i]);
-				}
+				result.faceLocations->SetValue(cellId, resultFaceStream - result.faces->GetPointer(0));
+				resultFaceStream = std::copy(faceStream + locations[p_cells[cellId]], faceStream + locations[p_cells[cellId]] + faceStreamSize, resultFaceStream);
 			}
+			else
+			{
+				result.faceLocations->SetValue(cellId, -1);
+			}
+		}
+	}
+
+	return result;
+}
 
-			vtk_unstructuredGrid->InsertNextCell(VTK_POLYHEDRON, idList);
+//----------------------------------------------------------------------------
+unsigned char ResqmlUnstructuredGridToVtkUnstructuredGrid::getVtkCellType(uint64_t cellIndex) const
+{
+	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
+
+	// Following https://kitware.github.io/vtk-examples/site/VTKBook/05Chapter5/#Figure%205-2
+	const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+	if (localFaceCount == 4)
+	{
+		return VTK_TETRA;
+	}
+	if (localFaceCount < 4 || localFaceCount > 8)
+	{
+		return VTK_POLYHEDRON;
+	}
+
+	// Count of faces with 4, 5 and 6 nodes
+	std::array<uint_fast8_t, 7> faceCountPerNodeCount = {0, 0, 0, 0, 0, 0, 0};
+	for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+	{
+		const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
+		if (localNodeCount < faceCountPerNodeCount.size())
+		{
+			++faceCountPerNodeCount[localNodeCount];
 		}
 	}
 
-	const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->unloadGeometry();
+	switch (localFaceCount)
+	{
+	case 5:
+		if (faceCountPerNodeCount[4] == 3)
+		{
+			return VTK_WEDGE;
+		}
+		if (faceCountPerNodeCount[4] == 1)
+		{
+			return VTK_PYRAMID;
+		}
+		return VTK_EMPTY_CELL;
+	case 6:
+		return faceCountPerNodeCount[4] == 6 ? VTK_HEXAHEDRON : VTK_POLYHEDRON;
+	case 7:
+		return faceCountPerNodeCount[5] == 2 && faceCountPerNodeCount[4] == 5 ? VTK_PENTAGONAL_PRISM : VTK_POLYHEDRON;
+	default:
+		return faceCountPerNodeCount[6] == 2 && faceCountPerNodeCount[4] == 6 ? VTK_HEXAGONAL_PRISM : VTK_POLYHEDRON;
+	}
+}
 
-	_vtkData->SetPartition(0, vtk_unstructuredGrid);
-	_vtkData->Modified();
+//----------------------------------------------------------------------------
+uint64_t ResqmlUnstructuredGridToVtkUnstructuredGrid::getPolyhedronNodes(uint64_t cellIndex, std::vector<uint64_t> &p_nodes) const
+{
+	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
+
+	p_nodes.clear();
+	const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+	for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+	{
+		const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
+		uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
+		p_nodes.insert(p_nodes.end(), nodeIndices, nodeIndices + localNodeCount);
+	}
+	const uint64_t faceStreamSize = 1 + localFaceCount + p_nodes.size();
+
+	std::sort(p_nodes.begin(), p_nodes.end());
+	p_nodes.erase(std::unique(p_nodes.begin(), p_nodes.end()), p_nodes.end());
+
+	return faceStreamSize;
 }
+
+//----------------------------------------------------------------------------
+std::vector<uint64_t> ResqmlUnstructuredGridToVtkUnstructuredGrid::getNodesOfCells(const std::vector<uint64_t> &p_cells) const
+{
+	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
+
+	std::vector<uint64_t> cellNodes;
+	for (const uint64_t cellIndex : p_cells)
+	{
+		const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+		for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+		{
+			const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
+			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
+			cellNodes.insert(cellNodes.end(), nodeIndices, nodeIndices + localNodeCount);
+		}
+	}
+	std::sort(cellNodes.begin(), cellNodes.end());
+	cellNodes.erase(std::unique(cellNodes.begin(), cellNodes.end()), cellNodes.end());
+
+	return cellNodes;
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkPoints> ResqmlUnstructuredGridToVtkUnstructuredGrid::getVtkPoints()
 {
@@ -161,11 +585,73 @@ vtkSmartPointer<vtkPoints> ResqmlUnstructuredGridToVtkUnstructuredGrid::getVtkPo
 
 //----------------------------------------------------------------------------
 void ResqmlUnstructuredGridToVtkUnstructuredGrid::createPoints()
+{
+	this->points = createPointsOfNodes(_vtkPointToResqmlPoint);
+}
+
+//----------------------------------------------------------------------------
+EML2_NS::AbstractHdfProxy *ResqmlUnstructuredGridToVtkUnstructuredGrid::getPointsDataset(std::string &p_datasetPath) const
+{
+	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
+	try
+	{
+		// The points of a RESQML 2.0.1 grid in a single 2d HDF5 dataset : node, coordinate
+		gsoap_resqml2_0_1::_resqml20__UnstructuredGridRepresentation const *gsoapGrid = dynamic_cast<gsoap_resqml2_0_1::_resqml20__UnstructuredGridRepresentation const *>(unstructuredGrid->getEml20GsoapProxy());
+		if (gsoapGrid == nullptr || unstructuredGrid->getPatchCount() != 1 ||
+			gsoapGrid->Geometry == nullptr || gsoapGrid->Geometry->Points == nullptr ||
+			gsoapGrid->Geometry->Points->soap_type() != SOAP_TYPE_gsoap_resqml2_0_1_resqml20__Point3dHdf5Array)
+		{
+			return nullptr;
+		}
+		gsoap_resqml2_0_1::eml20__Hdf5Dataset const *coordinates = static_cast<gsoap_resqml2_0_1::resqml20__Point3dHdf5Array const *>(gsoapGrid->Geometry->Points)->Coordinates;
+		EML2_NS::AbstractHdfProxy *hdfProxy = unstructuredGrid->getRepository()->getDataObjectByUuid<EML2_NS::AbstractHdfProxy>(coordinates->HdfProxy->UUID);
+		if (hdfProxy == nullptr || hdfProxy->isPartial() || hdfProxy->getDimensionCount(coordinates->PathInHdfFile) != 2)
+		{
+			return nullptr;
+		}
+		p_datasetPath = coordinates->PathInHdfFile;
+		return hdfProxy;
+	}
+	catch (const std::exception &)
+	{
+		return nullptr;
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::readXyzPointsOfNodes(EML2_NS::AbstractHdfProxy *p_hdfProxy, const std::string &p_datasetPath, const std::vector<uint64_t> &p_nodes, double *p_xyzPoints) const
+{
+	// A run holds at most 24 MB of coordinates, and stops before a gap of more than 1024 nodes which would be read for nothing
+	const uint64_t maxRunNodeCount = 1024 * 1024;
+	const uint64_t maxGapNodeCount = 1024;
+
+	std::unique_ptr<double[]> runXyzPoints(new double[std::min(maxRunNodeCount, p_nodes.back() - p_nodes.front() + 1) * 3]);
+	std::vector<uint64_t>::const_iterator keptNode = p_nodes.begin();
+	while (keptNode != p_nodes.end())
+	{
+		const uint64_t runFirstNode = *keptNode;
+		uint64_t runLastNode = runFirstNode;
+		std::vector<uint64_t>::const_iterator runEnd = keptNode;
+		for (; runEnd != p_nodes.end() && *runEnd - runFirstNode < maxRunNodeCount && *runEnd - runLastNode <= maxGapNodeCount; ++runEnd)
+		{
+			runLastNode = *runEnd;
+		}
+		const uint64_t numValuesInEachDimension[2] = {runLastNode - runFirstNode + 1, 3};
+		const uint64_t offsetInEachDimension[2] = {runFirstNode, 0};
+		p_hdfProxy->readArrayNdOfDoubleValues(p_datasetPath, runXyzPoints.get(), numValuesInEachDimension, offsetInEachDimension, 2);
+		for (; keptNode != runEnd; ++keptNode)
+		{
+			p_xyzPoints = std::copy_n(runXyzPoints.get() + (*keptNode - runFirstNode) * 3, 3, p_xyzPoints);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> ResqmlUnstructuredGridToVtkUnstructuredGrid::createPointsOfNodes(const std::vector<uint64_t> &p_nodes)
 {
 	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
 
 	// POINTS
-	double *allXyzPoints = new double[_pointCount * 3]; // Will be deleted by VTK;
 	bool partialCRS = false;
 	const uint64_t patchCount = unstructuredGrid->getPatchCount();
 	for (uint_fast64_t patchIndex = 0; patchIndex < patchCount; ++patchIndex)
@@ -179,14 +665,71 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::createPoints()
 	if (partialCRS)
 	{
 		vtkOutputWindowDisplayWarningText(("At least one of the local CRS of  : " + unstructuredGrid->getUuid() + " is partial. Get coordinates in local CRS instead.\n").c_str());
-		unstructuredGrid->getXyzPointsOfAllPatches(allXyzPoints);
+	}
+
+	const uint64_t pointCount = p_nodes.empty() ? _pointCount : p_nodes.size();
+	double *allXyzPoints = new double[pointCount * 3]; // Will be deleted by VTK;
+	if (p_nodes.empty())
+	{
+		if (partialCRS)
+		{
+			unstructuredGrid->getXyzPointsOfAllPatches(allXyzPoints);
+		}
+		else
+		{
+			unstructuredGrid->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints);
+		}
 	}
 	else
 	{
-		unstructuredGrid->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints);
+		// Read the asked nodes by bounded runs of close nodes, else the patches one by one, only keeping the asked nodes
+		bool isRead = false;
+		std::string datasetPath;
+		EML2_NS::AbstractHdfProxy *hdfProxy = getPointsDataset(datasetPath);
+		if (hdfProxy != nullptr)
+		{
+			try
+			{
+				readXyzPointsOfNodes(hdfProxy, datasetPath, p_nodes, allXyzPoints);
+				if (!partialCRS)
+				{
+					unstructuredGrid->getLocalCrs(0)->convertXyzPointsToGlobalCrs(allXyzPoints, pointCount);
+				}
+				isRead = true;
+			}
+			catch (const std::exception &)
+			{
+				// The storage does not read the points by hyperslab : fall back to the patches
+			}
+		}
+
+		std::vector<uint64_t>::const_iterator keptNode = p_nodes.begin();
+		double *keptXyzPoints = allXyzPoints;
+		uint64_t patchFirstNode = 0;
+		for (uint_fast64_t patchIndex = 0; !isRead && patchIndex < patchCount && keptNode != p_nodes.end(); ++patchIndex)
+		{
+			const uint64_t patchNodeCount = unstructuredGrid->getXyzPointCountOfPatch(patchIndex);
+			if (*keptNode < patchFirstNode + patchNodeCount)
+			{
+				std::unique_ptr<double[]> patchXyzPoints(new double[patchNodeCount * 3]);
+				if (partialCRS)
+				{
+					unstructuredGrid->getXyzPointsOfPatch(patchIndex, patchXyzPoints.get());
+				}
+				else
+				{
+					unstructuredGrid->getXyzPointsOfPatchInGlobalCrs(patchIndex, patchXyzPoints.get());
+				}
+				for (; keptNode != p_nodes.end() && *keptNode < patchFirstNode + patchNodeCount; ++keptNode)
+				{
+					keptXyzPoints = std::copy_n(patchXyzPoints.get() + (*keptNode - patchFirstNode) * 3, 3, keptXyzPoints);
+				}
+			}
+			patchFirstNode += patchNodeCount;
+		}
 	}
 
-	const uint64_t coordCount =_pointCount * 3;
+	const uint64_t coordCount = pointCount * 3;
 	if (!partialCRS && unstructuredGrid->getLocalCrs(0)->isDepthOriented())
 	{
 		for (uint_fast64_t zCoordIndex = 2; zCoordIndex < coordCount; zCoordIndex += 3)
@@ -194,17 +737,11 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::createPoints()
 			allXyzPoints[zCoordIndex] *= -1;
 		}
 	}
-	vtkSmartPointer<vtkDoubleArray> vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
-	vtkUnderlyingArray->SetNumberOfComponents(3);
-	// Take ownership of the underlying C array
-	vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-	this->points->SetData(vtkUnderlyingArray);
+	return createVtkPoints(allXyzPoints, pointCount);
 }
 
 //----------------------------------------------------------------------------
-void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkTetra(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-															   uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
-															   uint64_t cellIndex)
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkTetra(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const
 {
 	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
 
@@ -215,15 +752,15 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkTetra(vtkSmartPointer<v
 							   : cumulativeFaceCountPerCell[cellIndex - 1];
 	if (cellFaceNormalOutwardlyDirected[cellFaceIndex] == 0)
 	{ // The RESQML orientation of face 0 honors the VTK orientation of face 0 i.e. the face 0 normal defined using a right hand rule is inwardly directed.
-		nodes[0] = nodeIndices[0];
-		nodes[1] = nodeIndices[1];
-		nodes[2] = nodeIndices[2];
+		p_cellNodes[0] = nodeIndices[0];
+		p_cellNodes[1] = nodeIndices[1];
+		p_cellNodes[2] = nodeIndices[2];
 	}
 	else
 	{ // The RESQML orientation of face 0 does not honor the VTK orientation of face 0
-		nodes[0] = nodeIndices[2];
-		nodes[1] = nodeIndices[1];
-		nodes[2] = nodeIndices[0];
+		p_cellNodes[0] = nodeIndices[2];
+		p_cellNodes[1] = nodeIndices[1];
+		p_cellNodes[2] = nodeIndices[0];
 	}
 
 	// Face 1
@@ -231,20 +768,16 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkTetra(vtkSmartPointer<v
 
 	for (size_t index = 0; index < 3; ++index)
 	{
-		if (std::find(nodes.data(), nodes.data() + 3, nodeIndices[index]) == nodes.data() + 3)
+		if (std::find(p_cellNodes, p_cellNodes + 3, nodeIndices[index]) == p_cellNodes + 3)
 		{
-			nodes[3] = nodeIndices[index];
+			p_cellNodes[3] = nodeIndices[index];
 			break;
 		}
 	}
-
-	vtk_unstructuredGrid->InsertNextCell(VTK_TETRA, 4, nodes.data());
 }
 
 //----------------------------------------------------------------------------
-void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-																		uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
-																		uint64_t cellIndex)
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const
 {
 	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
 
@@ -275,7 +808,7 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 				{
 					for (size_t i = 0; i < 3; ++i)
 					{
-						nodes[i] = nodeIndices[2 - i];
+						p_cellNodes[i] = nodeIndices[2 - i];
 					}
 				}
 				else
@@ -283,7 +816,7 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 					// The RESQML orientation of face 0 honors the VTK orientation of face 0 i.e. the face 0 normal defined using a right hand rule is outwardly directed.
 					for (size_t i = 0; i < 3; ++i)
 					{
-						nodes[i] = nodeIndices[i];
+						p_cellNodes[i] = nodeIndices[i];
 					}
 				}
 				++triangleIndex;
@@ -297,30 +830,30 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 			if (localNodeCount == 4)
 			{
 				uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
-				if (nodeIndices[0] == nodes[0])
+				if (nodeIndices[0] == p_cellNodes[0])
 				{
-					nodes[3] = nodeIndices[1] == nodes[1] || nodeIndices[1] == nodes[2]
+					p_cellNodes[3] = nodeIndices[1] == p_cellNodes[1] || nodeIndices[1] == p_cellNodes[2]
 								   ? nodeIndices[3]
 								   : nodeIndices[1];
 					break;
 				}
-				else if (nodeIndices[1] == nodes[0])
+				else if (nodeIndices[1] == p_cellNodes[0])
 				{
-					nodes[3] = nodeIndices[2] == nodes[1] || nodeIndices[2] == nodes[2]
+					p_cellNodes[3] = nodeIndices[2] == p_cellNodes[1] || nodeIndices[2] == p_cellNodes[2]
 								   ? nodeIndices[0]
 								   : nodeIndices[2];
 					break;
 				}
-				else if (nodeIndices[2] == nodes[0])
+				else if (nodeIndices[2] == p_cellNodes[0])
 				{
-					nodes[3] = nodeIndices[3] == nodes[1] || nodeIndices[3] == nodes[2]
+					p_cellNodes[3] = nodeIndices[3] == p_cellNodes[1] || nodeIndices[3] == p_cellNodes[2]
 								   ? nodeIndices[1]
 								   : nodeIndices[3];
 					break;
 				}
-				else if (nodeIndices[3] == nodes[0])
+				else if (nodeIndices[3] == p_cellNodes[0])
 				{
-					nodes[3] = nodeIndices[0] == nodes[1] || nodeIndices[0] == nodes[2]
+					p_cellNodes[3] = nodeIndices[0] == p_cellNodes[1] || nodeIndices[0] == p_cellNodes[2]
 								   ? nodeIndices[2]
 								   : nodeIndices[0];
 					break;
@@ -334,50 +867,48 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 			if (localNodeCount == 3)
 			{
 				uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, triangleIndex);
-				if (nodeIndices[0] == nodes[3])
+				if (nodeIndices[0] == p_cellNodes[3])
 				{
 					if (cellFaceNormalOutwardlyDirected[globalFirstFaceIndex + triangleIndex] == 0)
 					{
-						nodes[4] = nodeIndices[1];
-						nodes[5] = nodeIndices[2];
+						p_cellNodes[4] = nodeIndices[1];
+						p_cellNodes[5] = nodeIndices[2];
 					}
 					else
 					{
-						nodes[4] = nodeIndices[2];
-						nodes[5] = nodeIndices[1];
+						p_cellNodes[4] = nodeIndices[2];
+						p_cellNodes[5] = nodeIndices[1];
 					}
 				}
-				else if (nodeIndices[1] == nodes[3])
+				else if (nodeIndices[1] == p_cellNodes[3])
 				{
 					if (cellFaceNormalOutwardlyDirected[globalFirstFaceIndex + triangleIndex] == 0)
 					{
-						nodes[4] = nodeIndices[2];
-						nodes[5] = nodeIndices[0];
+						p_cellNodes[4] = nodeIndices[2];
+						p_cellNodes[5] = nodeIndices[0];
 					}
 					else
 					{
-						nodes[4] = nodeIndices[0];
-						nodes[5] = nodeIndices[2];
+						p_cellNodes[4] = nodeIndices[0];
+						p_cellNodes[5] = nodeIndices[2];
 					}
 				}
-				else if (nodeIndices[2] == nodes[3])
+				else if (nodeIndices[2] == p_cellNodes[3])
 				{
 					if (cellFaceNormalOutwardlyDirected[globalFirstFaceIndex + triangleIndex] == 0)
 					{
-						nodes[4] = nodeIndices[0];
-						nodes[5] = nodeIndices[1];
+						p_cellNodes[4] = nodeIndices[0];
+						p_cellNodes[5] = nodeIndices[1];
 					}
 					else
 					{
-						nodes[4] = nodeIndices[1];
-						nodes[5] = nodeIndices[0];
+						p_cellNodes[4] = nodeIndices[1];
+						p_cellNodes[5] = nodeIndices[0];
 					}
 				}
 				break;
 			}
 		}
-
-		vtk_unstructuredGrid->InsertNextCell(VTK_WEDGE, 6, nodes.data());
 	}
 	else if (localFaceIndexWith4Nodes.size() == 1)
 	{ // VTK_PYRAMID
@@ -388,17 +919,17 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 							   localFaceIndexWith4Nodes[0];
 		if (cellFaceNormalOutwardlyDirected[cellFaceIndex] == 0)
 		{ // The RESQML orientation of the face honors the VTK orientation of face 0 i.e. the face 0 normal defined using a right hand rule is inwardly directed.
-			nodes[0] = nodeIndices[0];
-			nodes[1] = nodeIndices[1];
-			nodes[2] = nodeIndices[2];
-			nodes[3] = nodeIndices[3];
+			p_cellNodes[0] = nodeIndices[0];
+			p_cellNodes[1] = nodeIndices[1];
+			p_cellNodes[2] = nodeIndices[2];
+			p_cellNodes[3] = nodeIndices[3];
 		}
 		else
 		{ // The RESQML orientation of the face does not honor the VTK orientation of face 0
-			nodes[0] = nodeIndices[3];
-			nodes[1] = nodeIndices[2];
-			nodes[2] = nodeIndices[1];
-			nodes[3] = nodeIndices[0];
+			p_cellNodes[0] = nodeIndices[3];
+			p_cellNodes[1] = nodeIndices[2];
+			p_cellNodes[2] = nodeIndices[1];
+			p_cellNodes[3] = nodeIndices[0];
 		}
 
 		// Face with 3 points
@@ -406,14 +937,12 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 
 		for (size_t index = 0; index < 3; ++index)
 		{
-			if (std::find(nodes.data(), nodes.data() + 4, nodeIndices[index]) == nodes.data() + 4)
+			if (std::find(p_cellNodes, p_cellNodes + 4, nodeIndices[index]) == p_cellNodes + 4)
 			{
-				nodes[4] = nodeIndices[index];
+				p_cellNodes[4] = nodeIndices[index];
 				break;
 			}
 		}
-
-		vtk_unstructuredGrid->InsertNextCell(VTK_PYRAMID, 5, nodes.data());
 	}
 	else
 	{
@@ -422,38 +951,27 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 }
 
 //----------------------------------------------------------------------------
-bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexahedron(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-																	uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
-																	uint64_t cellIndex)
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexahedron(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const
 {
 	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
 
-	for (unsigned int localFaceIndex = 0; localFaceIndex < 6; ++localFaceIndex)
-	{
-		int test = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
-		if (unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex) != 4)
-		{
-			return false;
-		}
-	}
-
 	uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, 0);
 	const size_t cellFaceIndex = unstructuredGrid->isFaceCountOfCellsConstant() || cellIndex == 0
 									 ? cellIndex * 6
 									 : cumulativeFaceCountPerCell[cellIndex - 1];
 	if (cellFaceNormalOutwardlyDirected[cellFaceIndex] == 0)
 	{ // The RESQML orientation of the face honors the VTK orientation of face 0 i.e. the face 0 normal defined using a right hand rule is inwardly directed.
-		nodes[0] = nodeIndices[0];
-		nodes[1] = nodeIndices[1];
-		nodes[2] = nodeIndices[2];
-		nodes[3] = nodeIndices[3];
+		p_cellNodes[0] = nodeIndices[0];
+		p_cellNodes[1] = nodeIndices[1];
+		p_cellNodes[2] = nodeIndices[2];
+		p_cellNodes[3] = nodeIndices[3];
 	}
 	else
 	{ // The RESQML orientation of the face does not honor the VTK orientation of face 0
-		nodes[0] = nodeIndices[3];
-		nodes[1] = nodeIndices[2];
-		nodes[2] = nodeIndices[1];
-		nodes[3] = nodeIndices[0];
+		p_cellNodes[0] = nodeIndices[3];
+		p_cellNodes[1] = nodeIndices[2];
+		p_cellNodes[2] = nodeIndices[1];
+		p_cellNodes[3] = nodeIndices[0];
 	}
 
 	// Find the opposite neighbors of the nodes already got
@@ -463,15 +981,15 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexahedron(vtkSmartPoin
 		nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
 		for (size_t index = 0; index < 4; ++index)
 		{																					// Loop on face nodes
-			vtkIdType *itr = std::find(nodes.data(), nodes.data() + 4, nodeIndices[index]); // Locate a node on face 0
-			if (itr != nodes.data() + 4)
+			vtkIdType *itr = std::find(p_cellNodes, p_cellNodes + 4, nodeIndices[index]); // Locate a node on face 0
+			if (itr != p_cellNodes + 4)
 			{
 				// A top neighbor node can be found
-				const size_t topNeigborIdx = std::distance(nodes.data(), itr);
+				const size_t topNeigborIdx = std::distance(p_cellNodes, itr);
 				if (!alreadyTreated[topNeigborIdx])
 				{
 					const size_t previousIndex = index == 0 ? 3 : index - 1;
-					nodes[topNeigborIdx + 4] = std::find(nodes.data(), nodes.data() + 4, nodeIndices[previousIndex]) != nodes.data() + 4 // If previous index is also in face 0
+					p_cellNodes[topNeigborIdx + 4] = std::find(p_cellNodes, p_cellNodes + 4, nodeIndices[previousIndex]) != p_cellNodes + 4 // If previous index is also in face 0
 												   ? nodeIndices[index == 3 ? 0 : index + 1]											 // Put next index
 												   : nodeIndices[previousIndex];														 // Put previous index
 					alreadyTreated[topNeigborIdx] = true;
@@ -479,14 +997,10 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexahedron(vtkSmartPoin
 			}
 		}
 	}
-
-	vtk_unstructuredGrid->InsertNextCell(VTK_HEXAHEDRON, 8, nodes.data());
-	return true;
 }
 
 //----------------------------------------------------------------------------
-bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkPentagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-																		 uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex)
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkPentagonalPrism(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const
 {
 	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
 
@@ -504,19 +1018,17 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkPentagonalPrism(vtkSmar
 			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
 			if (cellFaceNormalOutwardlyDirected[cellFaceIndex] == 0)
 			{ // The RESQML orientation of the face honors the VTK orientation of face 0 i.e. the face 0 normal defined using a right hand rule is inwardly directed.
-				std::copy(nodeIndices, nodeIndices + 5, nodes.data());
+				std::copy(nodeIndices, nodeIndices + 5, p_cellNodes);
 			}
 			else
 			{ // The RESQML orientation of the face does not honor the VTK orientation of face 0
-				std::reverse_copy(nodeIndices, nodeIndices + 5, nodes.data());
+				std::reverse_copy(nodeIndices, nodeIndices + 5, p_cellNodes);
 			}
 			break; // We have found the base face
 		}
 	}
 
 	// Find the other nodes from the 4 nodes faces
-	uint_fast8_t faceWith5Nodes = 0;
-	uint_fast8_t faceWith4Nodes = 0;
 	std::array<bool, 5> alreadyTreated = {false, false, false, false, false};
 	for (uint32_t localFaceIndex = 0; localFaceIndex < 7; ++localFaceIndex)
 	{
@@ -526,40 +1038,27 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkPentagonalPrism(vtkSmar
 			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
 			for (size_t index = 0; index < 4; ++index) // Loop on face nodes
 			{
-				vtkIdType *itr = std::find(nodes.data(), nodes.data() + 5, nodeIndices[index]); // Locate a node on base face
-				if (itr != nodes.data() + 5)
+				vtkIdType *itr = std::find(p_cellNodes, p_cellNodes + 5, nodeIndices[index]); // Locate a node on base face
+				if (itr != p_cellNodes + 5)
 				{
 					// A top neighbor node can be found
-					const size_t topNeigborIdx = std::distance(nodes.data(), itr);
+					const size_t topNeigborIdx = std::distance(p_cellNodes, itr);
 					if (!alreadyTreated[topNeigborIdx])
 					{
 						const size_t previousIndex = index == 0 ? 3 : index - 1;
-						nodes[topNeigborIdx + 5] = std::find(nodes.data(), nodes.data() + 5, nodeIndices[previousIndex]) != nodes.data() + 5 // If previous index is also in face 0
+						p_cellNodes[topNeigborIdx + 5] = std::find(p_cellNodes, p_cellNodes + 5, nodeIndices[previousIndex]) != p_cellNodes + 5 // If previous index is also in face 0
 													   ? nodeIndices[index == 3 ? 0 : index + 1]											 // Put next index
 													   : nodeIndices[previousIndex];														 // Put previous index
 						alreadyTreated[topNeigborIdx] = true;
 					}
 				}
 			}
-			++faceWith4Nodes;
-		}
-		else if (localNodeCount == 5)
-		{
-			++faceWith5Nodes;
 		}
 	}
-
-	if (faceWith5Nodes == 2 && faceWith4Nodes == 5)
-	{
-		vtk_unstructuredGrid->InsertNextCell(VTK_PENTAGONAL_PRISM, 10, nodes.data());
-		return true;
-	}
-	return false;
 }
 
 //----------------------------------------------------------------------------
-bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-																		uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex)
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexagonalPrism(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const
 {
 	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
 
@@ -570,26 +1069,24 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexagonalPrism(vtkSmart
 		if (localNodeCount == 6)
 		{
 			const size_t cellFaceIndex = (unstructuredGrid->isFaceCountOfCellsConstant() || cellIndex == 0
-											  ? cellIndex * 7
+											  ? cellIndex * 8
 											  : cumulativeFaceCountPerCell[cellIndex - 1]) +
 										 localFaceIndex;
 
 			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
 			if (cellFaceNormalOutwardlyDirected[cellFaceIndex] == 0)
 			{ // The RESQML orientation of the face honors the VTK orientation of face 0 i.e. the face 0 normal defined using a right hand rule is inwardly directed.
-				std::copy(nodeIndices, nodeIndices + 6, nodes.data());
+				std::copy(nodeIndices, nodeIndices + 6, p_cellNodes);
 			}
 			else
 			{ // The RESQML orientation of the face does not honor the VTK orientation of face 0
-				std::reverse_copy(nodeIndices, nodeIndices + 6, nodes.data());
+				std::reverse_copy(nodeIndices, nodeIndices + 6, p_cellNodes);
 			}
 			break; // We have found the base face
 		}
 	}
 
 	// Find the other nodes from the 4 nodes faces
-	uint_fast8_t faceWith6Nodes = 0;
-	uint_fast8_t faceWith4Nodes = 0;
 	std::array<bool, 6> alreadyTreated = {false, false, false, false, false, false};
 	for (uint32_t localFaceIndex = 0; localFaceIndex < 8; ++localFaceIndex)
 	{
@@ -599,33 +1096,21 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexagonalPrism(vtkSmart
 			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
 			for (size_t index = 0; index < 4; ++index) // Loop on face nodes
 			{
-				vtkIdType *itr = std::find(nodes.data(), nodes.data() + 6, nodeIndices[index]); // Locate a node on base face
-				if (itr != nodes.data() + 6)
+				vtkIdType *itr = std::find(p_cellNodes, p_cellNodes + 6, nodeIndices[index]); // Locate a node on base face
+				if (itr != p_cellNodes + 6)
 				{
 					// A top neighbor node can be found
-					const size_t topNeigborIdx = std::distance(nodes.data(), itr);
+					const size_t topNeigborIdx = std::distance(p_cellNodes, itr);
 					if (!alreadyTreated[topNeigborIdx])
 					{
 						const size_t previousIndex = index == 0 ? 3 : index - 1;
-						nodes[topNeigborIdx + 6] = std::find(nodes.data(), nodes.data() + 6, nodeIndices[previousIndex]) != nodes.data() + 6 // If previous index is also in face 0
+						p_cellNodes[topNeigborIdx + 6] = std::find(p_cellNodes, p_cellNodes + 6, nodeIndices[previousIndex]) != p_cellNodes + 6 // If previous index is also in face 0
 													   ? nodeIndices[index == 3 ? 0 : index + 1]											 // Put next index
 													   : nodeIndices[previousIndex];														 // Put previous index
 						alreadyTreated[topNeigborIdx] = true;
 					}
 				}
 			}
-			++faceWith4Nodes;
-		}
-		else if (localNodeCount == 6)
-		{
-			++faceWith6Nodes;
 		}
 	}
-
-	if (faceWith6Nodes == 2 && faceWith4Nodes == 6)
-	{
-		vtk_unstructuredGrid->InsertNextCell(VTK_HEXAGONAL_PRISM, 12, nodes.data());
-		return true;
-	}
-	return false;
 }
@@ -19,14 +19,22 @@ under the License.
 #ifndef __ResqmlUnstructuredGridToVtkUnstructuredGrid_h
 #define __ResqmlUnstructuredGridToVtkUnstructuredGrid_h
 
-#include <array>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "ResqmlAbstractRepresentationToVtkPartitionedDataSet.h"
 
 // include VTK
 #include <vtkSmartPointer.h>
 #include <vtkUnstructuredGrid.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkIdTypeArray.h>
 
+namespace EML2_NS
+{
+	class AbstractHdfProxy;
+}
 namespace RESQML2_NS
 {
 	class UnstructuredGridRepresentation;
@@ -36,10 +44,34 @@ class ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid;
 class ResqmlUnstructuredGridToVtkUnstructuredGrid : public ResqmlAbstractRepresentationToVtkPartitionedDataSet
 {
 public:
+	/**
+	 * The VTK topology of some RESQML cells, the point ids being the RESQML node indices.
+	 */
+	struct Topology
+	{
+		vtkSmartPointer<vtkUnsignedCharArray> cellTypes;
+		vtkSmartPointer<vtkIdTypeArray> offsets;
+		vtkSmartPointer<vtkIdTypeArray> connectivity;
+		vtkSmartPointer<vtkIdTypeArray> faceLocations; // nullptr if there is no polyhedron
+		vtkSmartPointer<vtkIdTypeArray> faces;		   // nullptr if there is no polyhedron
+
+		/**
+		 * Set the cells of a VTK unstructured grid, sharing the arrays of this topology.
+		 */
+		void setCellsOf(vtkUnstructuredGrid *p_unstructuredGrid) const;
+
+		/**
+		 * Copy some cells of this topology.
+		 *
+		 * @param p_cells	The index in this topology of each cell to copy.
+		 */
+		Topology extract(const std::vector<uint64_t> &p_cells) const;
+	};
+
 	/**
 	 * Constructor
 	 */
-	explicit ResqmlUnstructuredGridToVtkUnstructuredGrid(const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1);
+	explicit ResqmlUnstructuredGridToVtkUnstructuredGrid(const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1, bool p_ghostCellLayer = false);
 
 	/**
 	 * load vtkDataSet with resqml data
@@ -51,88 +83,145 @@ public:
 	 */
 	void createPoints();
 
+	/**
+	 * Create the VTK points of some nodes of the grid, for instance the ones of a subrepresentation.
+	 *
+	 * @param p_nodes	The sorted RESQML index of each node. All the nodes of the grid if empty.
+	 */
+	vtkSmartPointer<vtkPoints> createPointsOfNodes(const std::vector<uint64_t> &p_nodes);
+
+	/**
+	 * Get the topology of some cells of the grid, for instance the ones of a subrepresentation.
+	 * If this mapper has already converted the topology of the whole grid, the cells are copied from it, else only these cells are converted.
+	 *
+	 * @param p_cells	The RESQML index of each cell.
+	 */
+	std::shared_ptr<const Topology> getTopologyOfCells(const std::vector<uint64_t> &p_cells);
+
 protected:
 	const RESQML2_NS::UnstructuredGridRepresentation *getResqmlData() const;
 	vtkSmartPointer<vtkPoints> points;
-	// Index of the nodes constituting a single VTK optimized cell
-	// The VTK HEXAGONALN PRISM is the VTK optimized cell containing the maximum number of nodes which is 12 as the size of this array.
-	std::array<vtkIdType, 12> nodes;
+
+	// Add the cells of the other processes which share a node with the cells of this process
+	bool _ghostCellLayer;
+
+	// The topology of the whole grid, once converted. Only used if this mapper loads the whole grid.
+	std::shared_ptr<const Topology> _topology;
 
 private:
+	/**
+	 * Get the topology of all the cells of the grid, converted at the first call.
+	 */
+	std::shared_ptr<const Topology> getTopology();
+
+	/**
+	 * Get the cells loaded by this process : its own cell range then, if asked, the ghost cells.
+	 * The geometry of the RESQML unstructured grid must be loaded.
+	 *
+	 * @param p_ownedCellCount	Set to the count of cells owned by this process, which are the first ones.
+	 * @return					The RESQML index of each loaded cell.
+	 */
+	std::vector<uint64_t> getLoadedCells(uint64_t &p_ownedCellCount) const;
+
+	/**
+	 * Get the sorted RESQML indices of the nodes of some cells.
+	 * The geometry of the RESQML unstructured grid must be loaded.
+	 */
+	std::vector<uint64_t> getNodesOfCells(const std::vector<uint64_t> &p_cells) const;
+
 	/**
 	 *	Return The vtkPoints
 	 */
 	vtkSmartPointer<vtkPoints> getVtkPoints();
 
 	/**
-	 * Insert a new VTK tetrahedron corresponding to a particular RESQML cell
+	 * Get the HDF proxy and the path of the dataset of the points of the grid, if they can be read by hyperslab.
+	 *
+	 * @return	nullptr if the points are not in a single 2d HDF5 dataset.
+	 */
+	EML2_NS::AbstractHdfProxy *getPointsDataset(std::string &p_datasetPath) const;
+
+	/**
+	 * Read the local coordinates of some nodes of the grid by bounded runs of close nodes.
+	 *
+	 * @param p_nodes		The sorted RESQML index of each node, not empty.
+	 * @param p_xyzPoints	Receives the coordinates of each node, in the order of p_nodes.
+	 */
+	void readXyzPointsOfNodes(EML2_NS::AbstractHdfProxy *p_hdfProxy, const std::string &p_datasetPath, const std::vector<uint64_t> &p_nodes, double *p_xyzPoints) const;
+
+	/**
+	 * Convert some RESQML cells to a VTK topology.
+	 * The VTK cell types, offsets, connectivity and polyhedron face stream are sized exactly in a first pass and then filled in place.
+	 * Both passes run in parallel over the cells, the offsets coming from a prefix sum in between.
+	 * The geometry of the RESQML unstructured grid must be loaded.
+	 *
+	 * @param p_cells	The RESQML index of each VTK cell.
+	 */
+	std::shared_ptr<const Topology> convertCells(const std::vector<uint64_t> &p_cells) const;
+
+	/**
+	 * Get the VTK cell type a RESQML cell is mapped to, following https://kitware.github.io/vtk-examples/site/VTKBook/05Chapter5/#Figure%205-2
+	 *
+	 * @return	VTK_EMPTY_CELL if the RESQML cell has 5 faces but is neither a pyramid nor a wedge.
+	 */
+	unsigned char getVtkCellType(uint64_t cellIndex) const;
+
+	/**
+	 * Get the sorted unique RESQML indices of the nodes of a RESQML cell mapped to a VTK polyhedron.
+	 *
+	 * @return	The size of the VTK face stream of the polyhedron.
+	 */
+	uint64_t getPolyhedronNodes(uint64_t cellIndex, std::vector<uint64_t> &p_nodes) const;
+
+	/**
+	 * Write the points of the VTK tetrahedron corresponding to a particular RESQML cell
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell			The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
-	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
+	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped.
+	 * @param p_cellNodes						Receives the RESQML node indices of the VTK cell points.
 	 */
-	void cellVtkTetra(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-					  uint64_t const *cumulativeFaceCountPerCell,
-					  unsigned char const *cellFaceNormalOutwardlyDirected,
-					  uint64_t cellIndex);
+	void cellVtkTetra(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const;
 
 	/**
-	 * Insert a new VTK wedge or pyramid corresponding to a particular RESQML cell
+	 * Write the points of the VTK wedge or pyramid corresponding to a particular RESQML cell
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
-	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
+	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped.
+	 * @param p_cellNodes						Receives the RESQML node indices of the VTK cell points.
 	 */
-	void cellVtkWedgeOrPyramid(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-							   uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
-							   uint64_t cellIndex);
+	void cellVtkWedgeOrPyramid(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const;
 
 	/**
-	 * Insert a new VTK hexahedron corresponding to a particular RESQML cell only if the RESQML cell is Quadrilaterally-faced hexahedron.
+	 * Write the points of the VTK hexahedron corresponding to a particular Quadrilaterally-faced hexahedron RESQML cell.
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
-	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
-	 *
-	 * @return true if the hexahedron is a Quadrilaterally-faced one, false otherwise
+	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped.
+	 * @param p_cellNodes						Receives the RESQML node indices of the VTK cell points.
 	 */
-	bool cellVtkHexahedron(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-						   uint64_t const *cumulativeFaceCountPerCell,
-						   unsigned char const *cellFaceNormalOutwardlyDirected,
-						   uint64_t cellIndex);
+	void cellVtkHexahedron(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const;
 
 	/**
-	 * Insert a new VTK_PENTAGONAL_PRISM corresponding to a particular RESQML cell only if the RESQML cell contains two faces with 5 nodes.
+	 * Write the points of the VTK_PENTAGONAL_PRISM corresponding to a particular RESQML cell containing two faces with 5 nodes.
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
-	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
-	 *
-	 * @return true if the RESQML cell contains two faces with 5 nodes, false otherwise
+	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped.
+	 * @param p_cellNodes						Receives the RESQML node indices of the VTK cell points.
 	 */
-	bool cellVtkPentagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-								uint64_t const *cumulativeFaceCountPerCell,
-								unsigned char const *cellFaceNormalOutwardlyDirected,
-								uint64_t cellIndex);
+	void cellVtkPentagonalPrism(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const;
 
 	/**
-	 * Insert a new VTK_HEXAGONAL_PRISM corresponding to a particular RESQML cell only if the RESQML cell contains two faces with 5 nodes.
+	 * Write the points of the VTK_HEXAGONAL_PRISM corresponding to a particular RESQML cell containing two faces with 6 nodes.
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
-	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
-	 *
-	 * @return true if the RESQML cell contains two faces with 5 nodes, false otherwise
+	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped.
+	 * @param p_cellNodes						Receives the RESQML node indices of the VTK cell points.
 	 */
-	bool cellVtkHexagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
-							   uint64_t const *cumulativeFaceCountPerCell,
-							   unsigned char const *cellFaceNormalOutwardlyDirected,
-							   uint64_t cellIndex);
+	void cellVtkHexagonalPrism(uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex, vtkIdType *p_cellNodes) const;
 
 	friend class ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid;
 };
@@ -63,7 +63,6 @@ void ResqmlWellboreChannelToVtkPolyData::loadVtkObject()
 	double *allXyzPoints = new double[_pointCount * 3]; // Will be deleted by VTK
 	frame->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints);
 
-	vtkSmartPointer<vtkPoints> vtkPts = vtkSmartPointer<vtkPoints>::New();
 	const size_t coordCount =_pointCount * 3;
 	if (frame->getLocalCrs(0)->isDepthOriented())
 	{
@@ -73,11 +72,7 @@ void ResqmlWellboreChannelToVtkPolyData::loadVtkObject()
 		}
 	}
 
-	vtkSmartPointer<vtkDoubleArray> vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
-	vtkUnderlyingArray->SetNumberOfComponents(3);
-	// Take ownership of the underlying C array
-	vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-	vtkPts->SetData(vtkUnderlyingArray);
+	vtkSmartPointer<vtkPoints> vtkPts = createVtkPoints(allXyzPoints, _pointCount);
 
 	auto lines = vtkSmartPointer<vtkCellArray>::New();
 	lines->InsertNextCell(_pointCount);
@@ -128,6 +123,7 @@ void ResqmlWellboreChannelToVtkPolyData::loadVtkObject()
 	tubeFilter->SetRadius(10);
 	tubeFilter->SetVaryRadiusToVaryRadiusByScalar();
 	tubeFilter->Update();
+	addGeometryOriginToFieldData(tubeFilter->GetOutput());
 
 	_vtkData->SetPartition(0, tubeFilter->GetOutput());
 	_vtkData->GetMetaData((unsigned int)0)->Set(vtkCompositeDataSet::NAME(), (const char*)(title+"("+uuid + ")").c_str());
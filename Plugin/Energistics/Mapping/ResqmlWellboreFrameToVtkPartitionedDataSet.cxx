@@ -41,4 +41,5 @@ void ResqmlWellboreFrameToVtkPartitionedDataSet::addChannel(const std::string& p
 {
 	const resqml2::WellboreFrameRepresentation* w_wellFrame = dynamic_cast<const resqml2::WellboreFrameRepresentation*>(_resqmlData);
 	_mapperSet.push_back(new ResqmlWellboreChannelToVtkPolyData(w_wellFrame, p_property, p_uuid));
+	_mapperSet.back()->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
 }
\ No newline at end of file
@@ -42,6 +42,7 @@ ResqmlWellboreMarkerFrameToVtkPartitionedDataSet::ResqmlWellboreMarkerFrameToVtk
 void ResqmlWellboreMarkerFrameToVtkPartitionedDataSet::addMarker(const RESQML2_NS::WellboreMarkerFrameRepresentation* p_marker, const std::string & p_uuid, bool p_orientation, uint32_t p_size)
 {
 	_mapperSet.push_back(new ResqmlWellboreMarkerToVtkPolyData(p_marker, p_uuid, p_orientation, p_size));
+	_mapperSet.back()->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
 }
 
 void ResqmlWellboreMarkerFrameToVtkPartitionedDataSet::changeOrientationAndSize(const std::string& p_uuid, bool p_orientation, uint32_t p_size)
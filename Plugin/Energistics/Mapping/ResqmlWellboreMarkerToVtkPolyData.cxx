@@ -161,13 +161,16 @@ void ResqmlWellboreMarkerToVtkPolyData::createDisk(uint32_t markerIndex)
 
 	// disk translation with marker position
 	const double zIndice = getResqmlData()->getLocalCrs(0)->isDepthOriented() ? -1 : 1;
+	const double markerPosition[3] = {doublePositions[3 * markerIndex], doublePositions[3 * markerIndex + 1], zIndice * doublePositions[3 * markerIndex + 2]};
+	const std::array<double, 3> origin = getGeometryOrigin(markerPosition);
 	vtkSmartPointer<vtkTransform> translation = vtkSmartPointer<vtkTransform>::New();
-	translation->Translate(doublePositions[3 * markerIndex], doublePositions[3 * markerIndex + 1], zIndice * doublePositions[3 * markerIndex + 2]);
+	translation->Translate(markerPosition[0] - origin[0], markerPosition[1] - origin[1], markerPosition[2] - origin[2]);
 
 	transformFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
 	transformFilter->SetInputData(vtkPolydata);
 	transformFilter->SetTransform(translation);
 	transformFilter->Update();
+	addGeometryOriginToFieldData(transformFilter->GetOutput());
 
 	_vtkData->SetPartition(0, transformFilter->GetOutput());
 }
@@ -183,9 +186,12 @@ void ResqmlWellboreMarkerToVtkPolyData::createSphere(uint32_t markerIndex)
 
 	// create  sphere
 	vtkSmartPointer<vtkSphereSource> sphereSource = vtkSmartPointer<vtkSphereSource>::New();
-	sphereSource->SetCenter(doublePositions[3 * markerIndex], doublePositions[3 * markerIndex + 1], zIndice * doublePositions[3 * markerIndex + 2]);
+	const double markerPosition[3] = {doublePositions[3 * markerIndex], doublePositions[3 * markerIndex + 1], zIndice * doublePositions[3 * markerIndex + 2]};
+	const std::array<double, 3> origin = getGeometryOrigin(markerPosition);
+	sphereSource->SetCenter(markerPosition[0] - origin[0], markerPosition[1] - origin[1], markerPosition[2] - origin[2]);
 	sphereSource->SetRadius(_size);
 	sphereSource->Update();
+	addGeometryOriginToFieldData(sphereSource->GetOutput());
 
 	_vtkData->SetPartition(0, sphereSource->GetOutput());
 }
@@ -61,7 +61,6 @@ void ResqmlWellboreTrajectoryToVtkPolyData::loadVtkObject()
 		// POINT
 		double *allXyzPoints = new double[_pointCount * 3]; // Will be deleted by VTK
 		wellbore->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints);
-		vtkSmartPointer<vtkPoints> vtkPts = vtkSmartPointer<vtkPoints>::New();
 
 		const size_t coordCount =_pointCount * 3;
 		if (wellbore->getLocalCrs(0)->isDepthOriented())
@@ -72,11 +71,7 @@ void ResqmlWellboreTrajectoryToVtkPolyData::loadVtkObject()
 			}
 		}
 
-		vtkSmartPointer<vtkDoubleArray> vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
-		vtkUnderlyingArray->SetNumberOfComponents(3);
-		// Take ownership of the underlying C array
-		vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		vtkPts->SetData(vtkUnderlyingArray);
+		vtkSmartPointer<vtkPoints> vtkPts = createVtkPoints(allXyzPoints, _pointCount);
 		vtk_polydata->SetPoints(vtkPts);
 
 		// POLYLINE
@@ -92,6 +87,8 @@ void ResqmlWellboreTrajectoryToVtkPolyData::loadVtkObject()
 
 		vtk_polydata->SetLines(setPolylineRepresentationLines);
 
+		addGeometryOriginToFieldData(vtk_polydata);
+
 		_vtkData->SetPartition(0, vtk_polydata);
 		_vtkData->Modified();
 	}
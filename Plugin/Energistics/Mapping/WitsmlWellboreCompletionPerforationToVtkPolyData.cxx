@@ -150,20 +150,30 @@ void WitsmlWellboreCompletionPerforationToVtkPolyData::loadVtkObject()
 	}
 
 	const double depthOriented = wellboreTrajectory->getLocalCrs(0)->isDepthOriented() ? -1 : 1;
-	// Create a vtkPoints object.
-	vtkSmartPointer<vtkPoints> vtkPts = vtkSmartPointer<vtkPoints>::New();
+	const size_t perforationPointCount = 2 + intermediateMdPoints.size();
+	double *allXyzPoints = new double[perforationPointCount * 3]; // Will be deleted by VTK
+	double *xyzPoint = allXyzPoints;
 
 	// Add the top point.
-	vtkPts->InsertNextPoint(xyzTrajValues[0], xyzTrajValues[1], xyzTrajValues[2] * depthOriented);
+	*xyzPoint++ = xyzTrajValues[0];
+	*xyzPoint++ = xyzTrajValues[1];
+	*xyzPoint++ = xyzTrajValues[2] * depthOriented;
 
 	// Add the intermediate points.
 	for (auto const &point : intermediateMdPoints)
 	{
-		vtkPts->InsertNextPoint(point[0], point[1], point[2] * depthOriented);
+		*xyzPoint++ = point[0];
+		*xyzPoint++ = point[1];
+		*xyzPoint++ = point[2] * depthOriented;
 	}
 
 	// Add the base point.
-	vtkPts->InsertNextPoint(xyzTrajValues[3], xyzTrajValues[4], xyzTrajValues[5] * depthOriented);
+	*xyzPoint++ = xyzTrajValues[3];
+	*xyzPoint++ = xyzTrajValues[4];
+	*xyzPoint = xyzTrajValues[5] * depthOriented;
+
+	// Create a vtkPoints object.
+	vtkSmartPointer<vtkPoints> vtkPts = createVtkPoints(allXyzPoints, perforationPointCount);
 
 	// Create a vtkCellArray object.
 	vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
@@ -185,6 +195,7 @@ void WitsmlWellboreCompletionPerforationToVtkPolyData::loadVtkObject()
 	tubeFilter->SetRadius(10);
 	tubeFilter->SetVaryRadiusToVaryRadiusByScalar();
 	tubeFilter->Update();
+	addGeometryOriginToFieldData(tubeFilter->GetOutput());
 
 	// Add the perforationPolyData to the vector.
 	_vtkData->SetPartition(0, tubeFilter->GetOutput());
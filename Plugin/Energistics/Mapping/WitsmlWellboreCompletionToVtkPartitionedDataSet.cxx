@@ -51,4 +51,5 @@ void WitsmlWellboreCompletionToVtkPartitionedDataSet::addPerforation(const std::
 {
 	const WITSML2_1_NS::WellboreCompletion *w_wellCompletion = dynamic_cast<const WITSML2_1_NS::WellboreCompletion *>(_resqmlData);
 	_mapperSet.push_back(new WitsmlWellboreCompletionPerforationToVtkPolyData(_wellboreTrajectory, w_wellCompletion, p_connectionuid, p_name, p_skin));
+	_mapperSet.back()->setGeometryPrecision(_geometryPrecision, _geometryOrigin);
 }
@@ -48,4 +48,33 @@ enum class TreeViewNodeType
 	Perforation
 };
 
+// the mapper class of a data object, resolved from its XML tag
+enum class MapperKind
+{
+	IjkGrid,
+	Grid2d,
+	TriangulatedSet,
+	PolylineSet,
+	UnstructuredGrid,
+	IjkGridSubRepresentation,
+	UnstructuredGridSubRepresentation,
+	WellboreTrajectory,
+	WellboreFrame,
+	WellboreMarkerFrame,
+	WellboreCompletion
+};
+
+enum class IjkPartitioning
+{
+	EqualK, // same count of K layers per process
+	BalancedK, // same count of cells with a defined geometry per process
+	Blocks // I, J and K blocks of the same size
+};
+
+enum class GeometryPrecision
+{
+	Double,
+	Float // relative to an origin stored in the field data
+};
+
 #endif // ENUM_H
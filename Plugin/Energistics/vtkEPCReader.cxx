@@ -41,7 +41,15 @@ vtkEPCReader::vtkEPCReader() : Files(vtkStringArray::New()),
                                Controller(nullptr),
                                AssemblyTag(0),
                                MarkerOrientation(true),
-                               MarkerSize(10)
+                               MarkerSize(10),
+                               ThreadCount(0),
+                               PropertyReadMemoryLimit(256),
+                               DeferredPropertyLoading(false),
+                               TimeStepPrefetchWindow(1),
+                               PointPrecision(0),
+                               IjkPartitioningMode(0),
+                               GhostCellLayer(false),
+                               SubRepresentationPointCompaction(false)
 {
   SetNumberOfInputPorts(0);
   SetNumberOfOutputPorts(1);
@@ -145,7 +153,7 @@ bool vtkEPCReader::AddSelector(const char *path)
 {
   if (path != nullptr && selectors.insert(path).second)
   {
-    int node_id = GetAssembly()->GetFirstNodeByPath(path);
+    int node_id = repository.findNodeByPath(path);
 
     if (node_id == -1)
     {
@@ -215,6 +223,119 @@ void vtkEPCReader::setMarkerOrientation(bool orientation)
   Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkEPCReader::setThreadCount(int count)
+{
+  if (count < 0)
+  {
+    vtkWarningMacro(<< "The thread count cannot be negative.");
+    return;
+  }
+  if (ThreadCount != count)
+  {
+    ThreadCount = count;
+    repository.setThreadCount(static_cast<uint32_t>(count));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setPropertyReadMemoryLimit(int megabytes)
+{
+  if (megabytes < 1)
+  {
+    vtkWarningMacro(<< "The property read memory limit must be at least 1 megabyte.");
+    return;
+  }
+  if (PropertyReadMemoryLimit != megabytes)
+  {
+    PropertyReadMemoryLimit = megabytes;
+    repository.setPropertyReadMemoryLimit(static_cast<uint32_t>(megabytes));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setDeferredPropertyLoading(bool deferred)
+{
+  if (DeferredPropertyLoading != deferred)
+  {
+    DeferredPropertyLoading = deferred;
+    repository.setDeferredPropertyLoading(deferred);
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setTimeStepPrefetchWindow(int stepCount)
+{
+  if (stepCount < 0)
+  {
+    vtkWarningMacro(<< "The time step prefetch window cannot be negative.");
+    return;
+  }
+  if (TimeStepPrefetchWindow != stepCount)
+  {
+    TimeStepPrefetchWindow = stepCount;
+    repository.setTimeStepPrefetchWindow(static_cast<uint32_t>(stepCount));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setGeometryPrecision(int precision)
+{
+  if (precision != 0 && precision != 1)
+  {
+    vtkWarningMacro(<< "The geometry precision must be 0 (double) or 1 (float).");
+    return;
+  }
+  if (PointPrecision != precision)
+  {
+    PointPrecision = precision;
+    repository.setGeometryPrecision(precision == 0 ? GeometryPrecision::Double : GeometryPrecision::Float);
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setIjkPartitioning(int partitioning)
+{
+  if (partitioning < 0 || partitioning > 2)
+  {
+    vtkWarningMacro(<< "The IJK grid partitioning must be 0 (equal K slabs), 1 (balanced active cells) or 2 (I, J, K blocks).");
+    return;
+  }
+  if (IjkPartitioningMode != partitioning)
+  {
+    IjkPartitioningMode = partitioning;
+    repository.setIjkPartitioning(static_cast<IjkPartitioning>(partitioning));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setGhostCellLayer(bool ghostCellLayer)
+{
+  if (GhostCellLayer != ghostCellLayer)
+  {
+    GhostCellLayer = ghostCellLayer;
+    repository.setGhostCellLayer(ghostCellLayer);
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setSubRepresentationPointCompaction(bool compaction)
+{
+  if (SubRepresentationPointCompaction != compaction)
+  {
+    SubRepresentationPointCompaction = compaction;
+    repository.setSubRepresentationPointCompaction(compaction);
+    Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkEPCReader::setMarkerSize(int size)
 {
@@ -232,7 +353,7 @@ int vtkEPCReader::RequestData(vtkInformation *,
   {
     for (auto path : selectorNotLoaded)
     {
-      int node_id = GetAssembly()->GetFirstNodeByPath(path.c_str());
+      int node_id = repository.findNodeByPath(path);
       if (node_id > -1)
       {
         repository.selectNodeId(node_id);
@@ -263,7 +384,8 @@ int vtkEPCReader::RequestData(vtkInformation *,
 
   try
   {
-    vtkPartitionedDataSetCollection::GetData(outInfo)->DeepCopy(repository.getVtkPartitionedDatasSetCollection(requestedTimeStep, Controller->GetNumberOfProcesses(), Controller->GetLocalProcessId()));
+    ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopyOutput(repository.getVtkPartitionedDatasSetCollection(requestedTimeStep, Controller->GetNumberOfProcesses(), Controller->GetLocalProcessId()),
+                                                                             vtkPartitionedDataSetCollection::GetData(outInfo));
     repository.closeFiles();
   }
   catch (const std::exception &e)
@@ -46,7 +46,15 @@ vtkETPSource::vtkETPSource() : ETPUrl("wss://osdu-ship.msft-osdu-test.org:443/oe
                                ConnectionTag(1),
                                DisconnectionTag(0),
                                MarkerOrientation(true),
-                               MarkerSize(10)
+                               MarkerSize(10),
+                               ThreadCount(0),
+                               PropertyReadMemoryLimit(256),
+                               DeferredPropertyLoading(false),
+                               TimeStepPrefetchWindow(1),
+                               PointPrecision(0),
+                               IjkPartitioningMode(0),
+                               GhostCellLayer(false),
+                               SubRepresentationPointCompaction(false)
 {
   SetNumberOfInputPorts(0);
   SetNumberOfOutputPorts(1);
@@ -153,7 +161,7 @@ bool vtkETPSource::AddSelector(const char *selector)
 {
   if (selector != nullptr && this->selectors.insert(selector).second)
   {
-    int node_id = GetAssembly()->GetFirstNodeByPath(selector);
+    int node_id = this->repository.findNodeByPath(selector);
     this->repository.selectNodeId(node_id);
     this->Modified();
     Modified();
@@ -223,6 +231,119 @@ void vtkETPSource::setMarkerOrientation(bool orientation)
   this->UpdateWholeExtent();
 }
 
+//----------------------------------------------------------------------------
+void vtkETPSource::setThreadCount(int count)
+{
+  if (count < 0)
+  {
+    vtkWarningMacro(<< "The thread count cannot be negative.");
+    return;
+  }
+  if (ThreadCount != count)
+  {
+    ThreadCount = count;
+    this->repository.setThreadCount(static_cast<uint32_t>(count));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkETPSource::setPropertyReadMemoryLimit(int megabytes)
+{
+  if (megabytes < 1)
+  {
+    vtkWarningMacro(<< "The property read memory limit must be at least 1 megabyte.");
+    return;
+  }
+  if (PropertyReadMemoryLimit != megabytes)
+  {
+    PropertyReadMemoryLimit = megabytes;
+    this->repository.setPropertyReadMemoryLimit(static_cast<uint32_t>(megabytes));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkETPSource::setDeferredPropertyLoading(bool deferred)
+{
+  if (DeferredPropertyLoading != deferred)
+  {
+    DeferredPropertyLoading = deferred;
+    this->repository.setDeferredPropertyLoading(deferred);
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkETPSource::setTimeStepPrefetchWindow(int stepCount)
+{
+  if (stepCount < 0)
+  {
+    vtkWarningMacro(<< "The time step prefetch window cannot be negative.");
+    return;
+  }
+  if (TimeStepPrefetchWindow != stepCount)
+  {
+    TimeStepPrefetchWindow = stepCount;
+    this->repository.setTimeStepPrefetchWindow(static_cast<uint32_t>(stepCount));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkETPSource::setGeometryPrecision(int precision)
+{
+  if (precision != 0 && precision != 1)
+  {
+    vtkWarningMacro(<< "The geometry precision must be 0 (double) or 1 (float).");
+    return;
+  }
+  if (PointPrecision != precision)
+  {
+    PointPrecision = precision;
+    this->repository.setGeometryPrecision(precision == 0 ? GeometryPrecision::Double : GeometryPrecision::Float);
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkETPSource::setIjkPartitioning(int partitioning)
+{
+  if (partitioning < 0 || partitioning > 2)
+  {
+    vtkWarningMacro(<< "The IJK grid partitioning must be 0 (equal K slabs), 1 (balanced active cells) or 2 (I, J, K blocks).");
+    return;
+  }
+  if (IjkPartitioningMode != partitioning)
+  {
+    IjkPartitioningMode = partitioning;
+    this->repository.setIjkPartitioning(static_cast<IjkPartitioning>(partitioning));
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkETPSource::setGhostCellLayer(bool ghostCellLayer)
+{
+  if (GhostCellLayer != ghostCellLayer)
+  {
+    GhostCellLayer = ghostCellLayer;
+    this->repository.setGhostCellLayer(ghostCellLayer);
+    Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkETPSource::setSubRepresentationPointCompaction(bool compaction)
+{
+  if (SubRepresentationPointCompaction != compaction)
+  {
+    SubRepresentationPointCompaction = compaction;
+    this->repository.setSubRepresentationPointCompaction(compaction);
+    Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkETPSource::setMarkerSize(int size)
 {
@@ -260,7 +381,8 @@ int vtkETPSource::RequestData(vtkInformation *,
 
   try
   {
-    vtkPartitionedDataSetCollection::GetData(outInfo)->DeepCopy(this->repository.getVtkPartitionedDatasSetCollection(requestedTimeStep));
+    ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopyOutput(this->repository.getVtkPartitionedDatasSetCollection(requestedTimeStep),
+                                                                             vtkPartitionedDataSetCollection::GetData(outInfo));
   }
   catch (const std::exception &e)
   {
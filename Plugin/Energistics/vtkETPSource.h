@@ -130,6 +130,63 @@ public:
 	void setMarkerSize(int size);
 	///@}
 
+	///@{
+	/**
+	* Maximum number of threads used to map the RESQML data (0 for the VTK SMP default).
+	* Lower it when several MPI ranks share the same node.
+	*/
+	void setThreadCount(int count);
+	///@}
+
+	///@{
+	/**
+	* Maximum memory in megabytes of the temporary buffer of each partial property read.
+	*/
+	void setPropertyReadMemoryLimit(int megabytes);
+	///@}
+
+	///@{
+	/**
+	* Only read the values of a property when a filter accesses them for the first time.
+	*/
+	void setDeferredPropertyLoading(bool deferred);
+	///@}
+
+	///@{
+	/**
+	* Number of time steps after the requested one whose time series properties are read on a background thread.
+	*/
+	void setTimeStepPrefetchWindow(int stepCount);
+	///@}
+
+	///@{
+	/**
+	* Precision of the points : 0 for double, 1 for float relative to an origin stored in the field data.
+	*/
+	void setGeometryPrecision(int precision);
+	///@}
+
+	///@{
+	/**
+	* Partitioning of the IJK grids among the processes : 0 for equal K slabs, 1 for K slabs balanced on the active cells, 2 for I, J, K blocks.
+	*/
+	void setIjkPartitioning(int partitioning);
+	///@}
+
+	///@{
+	/**
+	* Add a layer of ghost cells to the grid piece of each process.
+	*/
+	void setGhostCellLayer(bool ghostCellLayer);
+	///@}
+
+	///@{
+	/**
+	* Only keep in the subrepresentations the points referenced by their cells.
+	*/
+	void setSubRepresentationPointCompaction(bool compaction);
+	///@}
+
 protected:
 	vtkETPSource();
 	~vtkETPSource() override;
@@ -155,6 +212,14 @@ private:
 	// Properties
 	bool MarkerOrientation;
 	int MarkerSize;
+	int ThreadCount;
+	int PropertyReadMemoryLimit;
+	bool DeferredPropertyLoading;
+	int TimeStepPrefetchWindow;
+	int PointPrecision;
+	int IjkPartitioningMode;
+	bool GhostCellLayer;
+	bool SubRepresentationPointCompaction;
 
 	ResqmlDataRepositoryToVtkPartitionedDataSetCollection repository;
 };